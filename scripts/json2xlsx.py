@@ -70,8 +70,11 @@ def retrieve_rows(listofjsons):
             # if the file consists of a dictionnary of entries which keys are labelled '* thread-s',
             # we assume the file concatenate several testcase groups per number of threads.
             # treat it differently.
+            # other groups (e.g. 'scalability', coming from a thread-count sweep) are not test cases, and are skipped.
             if list(testcases.keys())[0].endswith('thread-s'):
                 for threadgroupname, threadgroup in testcases.items():
+                    if not threadgroupname.endswith('thread-s'):
+                        continue
                     for testcase,keys in threadgroup.items():
                         for key, vectors in keys.items():
                             for vectorname, vector in vectors.items():
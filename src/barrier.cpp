@@ -0,0 +1,58 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// barrier.cpp: a reusable barrier, to start threads together
+
+#include "barrier.hpp"
+
+
+std::chrono::steady_clock::time_point Barrier::arrive_and_wait()
+{
+    std::unique_lock<std::mutex> lck(m_mtx);
+    auto generation = m_generation;
+
+    if(++m_waiting == m_count) {
+	// last one to arrive: run the completion step, record the time and release everybody
+	if(m_completion) {
+	    m_completion();
+	}
+	m_release_time = std::chrono::steady_clock::now();
+	m_waiting = 0;
+	m_generation++;
+	m_cond.notify_all();
+    } else {
+	m_cond.wait(lck, [&] { return generation != m_generation; });
+    }
+
+    // the release time cannot be overwritten before we read it,
+    // as the next generation requires this thread to arrive again
+    return m_release_time;
+}
+
+void Barrier::reset(std::size_t count)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    m_count = count;
+    m_waiting = 0;
+}
+
+std::chrono::steady_clock::time_point Barrier::release_time()
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_release_time;
+}
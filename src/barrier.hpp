@@ -0,0 +1,57 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// barrier.hpp: a reusable barrier, to start threads together
+
+#if !defined(BARRIER_H)
+#define BARRIER_H
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+
+class Barrier
+{
+    std::mutex m_mtx;
+    std::condition_variable m_cond;
+    std::size_t m_count;	// number of participants
+    std::size_t m_waiting {0};	// number of participants arrived so far
+    std::size_t m_generation {0}; // incremented each time the barrier is released
+    std::chrono::steady_clock::time_point m_release_time {};
+    std::function<void()> m_completion; // called by the last participant, before releasing the others
+
+public:
+    explicit Barrier(std::size_t count, std::function<void()> completion = nullptr) : m_count(count), m_completion(completion) { }
+
+    Barrier( const Barrier &) = delete;
+    Barrier& operator=( const Barrier &) = delete;
+
+    // arrive_and_wait(): block until all participants have arrived.
+    // Returns the release time, which is identical for all participants of the same generation.
+    std::chrono::steady_clock::time_point arrive_and_wait();
+
+    // reset(): change the number of participants. Must not be called while participants are waiting.
+    void reset(std::size_t count);
+
+    // release_time(): time at which the barrier was last released
+    std::chrono::steady_clock::time_point release_time();
+};
+
+#endif // BARRIER_H
@@ -0,0 +1,117 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// bootstrap.cpp: bootstrap confidence intervals, for the mean and the order statistics of a sample
+
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <boost/math/distributions/normal.hpp>
+#include "bootstrap.hpp"
+
+namespace {
+    // quantile(): value at a fraction p of sorted values
+    double quantile(const std::vector<double> &sorted, double p)
+    {
+	auto index = static_cast<std::size_t>(std::clamp(std::ceil(p * sorted.size()), 1.0, static_cast<double>(sorted.size())));
+	return sorted[index - 1];
+    }
+}
+
+Bootstrap::Interval Bootstrap::mean(const std::vector<double> &sample) const
+{
+    const std::size_t n = sample.size();
+    if(n < 2 || m_resamples < 2) {
+	double value = n ? sample.front() : 0.0;
+	return { value, value };
+    }
+
+    double sum = 0.0;
+    for(auto x: sample) {
+	sum += x;
+    }
+    const double observed = sum / n;
+
+    // resamples are shared among workers, each with its own generator
+    std::vector<double> means(m_resamples);
+    const std::size_t workers = std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(), m_resamples));
+    std::vector<std::thread> threads;
+    for(std::size_t w=0; w<workers; w++) {
+	threads.emplace_back( [&, w] {
+	    std::mt19937_64 generator(m_seed + w);
+	    std::uniform_int_distribution<std::size_t> draw(0, n - 1);
+	    for(std::size_t b=w; b<m_resamples; b+=workers) {
+		double resum = 0.0;
+		for(std::size_t i=0; i<n; i++) {
+		    resum += sample[draw(generator)];
+		}
+		means[b] = resum / n;
+	    }
+	});
+    }
+    for(auto &thread: threads) {
+	thread.join();
+    }
+    std::sort(means.begin(), means.end());
+
+    // bias correction: the median bias of the resampled means, as a normal quantile
+    const boost::math::normal normal;
+    const double below = std::lower_bound(means.begin(), means.end(), observed) - means.begin();
+    const double B = m_resamples;
+    const double z0 = boost::math::quantile(normal, std::clamp(below / B, 1 / (B + 1), B / (B + 1)));
+
+    // acceleration, from the jackknife: for the mean, a = sum(d^3) / (6 (sum(d^2))^3/2), with d the deviations
+    double squares = 0.0, cubes = 0.0;
+    for(auto x: sample) {
+	double d = x - observed;
+	squares += d * d;
+	cubes += d * d * d;
+    }
+    const double a = squares > 0 ? cubes / (6 * std::pow(squares, 1.5)) : 0.0;
+
+    auto level = [&](double alpha) {
+	double z = boost::math::quantile(normal, alpha);
+	return boost::math::cdf(normal, z0 + (z0 + z) / (1 - a * (z0 + z)));
+    };
+
+    const double alpha = (1 - m_confidence) / 2;
+    return { quantile(means, level(alpha)), quantile(means, level(1 - alpha)) };
+}
+
+Bootstrap::Interval Bootstrap::rank(std::size_t n, std::size_t k, const std::function<double(std::size_t)> &at) const
+{
+    if(n == 0 || m_resamples < 2) {
+	return { 0.0, 0.0 };
+    }
+    k = std::clamp<std::size_t>(k, 1, n);
+
+    // U ~ Beta(k, n-k+1), drawn as X/(X+Y) with X ~ Gamma(k) and Y ~ Gamma(n-k+1); the resampled value is of rank ceil(n.U)
+    std::mt19937_64 generator(m_seed);
+    std::gamma_distribution<double> gx(static_cast<double>(k)), gy(static_cast<double>(n - k + 1));
+    std::vector<double> values(m_resamples);
+    for(auto &value: values) {
+	double x = gx(generator), y = gy(generator);
+	auto r = static_cast<std::size_t>(std::ceil(n * x / (x + y)));
+	value = at(std::clamp<std::size_t>(r, 1, n));
+    }
+    std::sort(values.begin(), values.end());
+
+    const double alpha = (1 - m_confidence) / 2;
+    return { quantile(values, alpha), quantile(values, 1 - alpha) };
+}
@@ -0,0 +1,61 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// bootstrap.hpp: bootstrap confidence intervals, for the mean and the order statistics of a sample
+//
+// The mean is resampled in full, by as many threads as the hardware offers, and its interval is BCa
+// (bias-corrected and accelerated; for the mean, the jackknife acceleration has a closed form).
+// Order statistics need no resampling: the value of rank k in a resample of n values is the empirical
+// quantile at the k-th smallest of n uniform draws, which follows a Beta(k, n-k+1) distribution.
+// Their interval is given by the percentile method.
+
+#if !defined(BOOTSTRAP_H)
+#define BOOTSTRAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+class Bootstrap
+{
+    std::size_t m_resamples;
+    double m_confidence;
+    uint64_t m_seed;
+
+public:
+    struct Interval {
+	double lower;
+	double upper;
+    };
+
+    // resamples are drawn from a fixed seed, so that results can be reproduced
+    Bootstrap(std::size_t resamples, double confidence = 0.95, uint64_t seed = 0x9e3779b97f4a7c15ULL)
+	: m_resamples(resamples), m_confidence(confidence), m_seed(seed) { }
+
+    inline std::size_t resamples() const { return m_resamples; }
+
+    // mean(): BCa interval of the mean of a sample
+    Interval mean(const std::vector<double> &sample) const;
+
+    // rank(): interval of the value of rank k (from 1) in a sample of n values, at(r) being the value of rank r
+    Interval rank(std::size_t n, std::size_t k, const std::function<double(std::size_t)> &at) const;
+};
+
+
+#endif // BOOTSTRAP_H
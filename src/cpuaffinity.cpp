@@ -0,0 +1,266 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// cpuaffinity.cpp: placement of benchmark threads on CPUs and NUMA nodes
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <map>
+#include <boost/tokenizer.hpp>
+#include "../config.h"
+#if defined(HAVE_PTHREAD_SETAFFINITY_NP)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "stringhash.hpp"
+#include "cpuaffinity.hpp"
+
+using namespace stringhash;
+
+namespace {
+
+    // parse_cpulist(): parse a list in the format used by the kernel, e.g. "0-3,8,10-11"
+    std::vector<int> parse_cpulist(const std::string &cpulist)
+    {
+	std::vector<int> cpus;
+	boost::char_separator<char> sep(",\n ");
+	boost::tokenizer<boost::char_separator<char> > toparse(cpulist, sep);
+
+	for(auto token : toparse) {
+	    std::size_t pos;
+	    int first = std::stoi(token, &pos);
+	    int last = first;
+	    if(pos < token.size()) {
+		if(token[pos] != '-') {
+		    throw std::invalid_argument("invalid CPU list: " + cpulist);
+		}
+		last = std::stoi(token.substr(pos+1));
+	    }
+	    if(first < 0 || last < first) {
+		throw std::invalid_argument("invalid CPU list: " + cpulist);
+	    }
+	    for(int cpu=first; cpu<=last; cpu++) {
+		cpus.push_back(cpu);
+	    }
+	}
+	return cpus;
+    }
+
+    // read_sysfs(): read the content of a sysfs entry, returns an empty string if it cannot be read
+    std::string read_sysfs(const std::string &path)
+    {
+	std::ifstream entry(path);
+	std::stringstream content;
+	content << entry.rdbuf();
+	return entry ? content.str() : std::string();
+    }
+
+    int read_sysfs_int(const std::string &path, int fallback)
+    {
+	auto content = read_sysfs(path);
+	return content.empty() ? fallback : std::stoi(content);
+    }
+
+    // the CPUs this process is allowed to run on
+    std::vector<int> allowed_cpus()
+    {
+	std::vector<int> cpus;
+#if defined(HAVE_PTHREAD_SETAFFINITY_NP)
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	if(sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+	    for(int cpu=0; cpu<CPU_SETSIZE; cpu++) {
+		if(CPU_ISSET(cpu, &mask)) {
+		    cpus.push_back(cpu);
+		}
+	    }
+	}
+#endif
+	return cpus;
+    }
+
+    struct CpuTopology {
+	int cpu;
+	int package;		// physical socket
+	int core;		// physical core, within the package
+	int sibling;		// rank of the hyperthread, within the core
+    };
+
+    std::vector<CpuTopology> discover_topology(const std::vector<int> &cpus)
+    {
+	std::vector<CpuTopology> topology;
+	std::map<std::pair<int,int>, int> siblings; // number of hyperthreads seen so far, per core
+
+	for(auto cpu: cpus) {	// CPUs are in ascending order
+	    std::string base { "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" };
+	    int package = read_sysfs_int(base + "physical_package_id", 0);
+	    int core = read_sysfs_int(base + "core_id", cpu);
+	    topology.push_back( { cpu, package, core, siblings[{package, core}]++ } );
+	}
+	return topology;
+    }
+}
+
+
+CpuAffinity::CpuAffinity(std::string policy) : m_name(policy)
+{
+    switch(stringhash::hash(policy)) {
+    case "none"_hash:
+	m_policy = Policy::none;
+	return;
+
+    case "compact"_hash:
+	m_policy = Policy::compact;
+	break;
+
+    case "scatter"_hash:
+	m_policy = Policy::scatter;
+	break;
+
+    case "numa"_hash:
+	m_policy = Policy::numa;
+	break;
+
+    default:
+	try {
+	    m_policy = Policy::list;
+	    for(auto cpu: parse_cpulist(policy)) {
+		m_slots.push_back( { cpu } );
+		m_slotnames.push_back( "cpu" + std::to_string(cpu) );
+	    }
+	} catch(std::logic_error &) { // std::stoi throws std::invalid_argument or std::out_of_range
+	    throw std::invalid_argument("unknown CPU affinity policy: " + policy);
+	}
+	if(m_slots.empty()) {
+	    throw std::invalid_argument("empty CPU list");
+	}
+    }
+
+#if !defined(HAVE_PTHREAD_SETAFFINITY_NP)
+    std::cerr << "*** Warning: CPU affinity is not supported on this platform, policy '" << policy << "' ignored.\n";
+    m_policy = Policy::none;
+    m_slots.clear();
+    m_slotnames.clear();
+#else
+    auto cpus = allowed_cpus();
+    if(cpus.empty()) {
+	throw std::invalid_argument("cannot retrieve the CPUs available to the process");
+    }
+
+    switch(m_policy) {
+    case Policy::compact:
+    case Policy::scatter: {
+	auto topology = discover_topology(cpus);
+	if(m_policy == Policy::compact) {
+	    std::stable_sort(topology.begin(), topology.end(), [](auto &a, auto &b) {
+		return std::tie(a.package, a.core, a.sibling) < std::tie(b.package, b.core, b.sibling);
+	    });
+	} else {
+	    // rank cores within each package, so that the n-th core of every package comes before the (n+1)-th
+	    std::map<std::pair<int,int>, int> corerank;
+	    std::map<int, int> cores_per_package;
+	    for(auto &t: topology) {
+		if(corerank.find({t.package, t.core}) == corerank.end()) {
+		    corerank[{t.package, t.core}] = cores_per_package[t.package]++;
+		}
+	    }
+	    std::stable_sort(topology.begin(), topology.end(), [&](auto &a, auto &b) {
+		return std::make_tuple(a.sibling, corerank[{a.package, a.core}], a.package)
+		    < std::make_tuple(b.sibling, corerank[{b.package, b.core}], b.package);
+	    });
+	}
+	for(auto &t: topology) {
+	    m_slots.push_back( { t.cpu } );
+	    m_slotnames.push_back( "cpu" + std::to_string(t.cpu) );
+	}
+	break;
+    }
+
+    case Policy::numa: {
+	auto online = read_sysfs("/sys/devices/system/node/online");
+	for(auto node: parse_cpulist(online.empty() ? "0" : online)) {
+	    std::vector<int> nodecpus;
+	    auto nodelist = read_sysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+	    // keep only the CPUs we are allowed to run on
+	    for(auto cpu: nodelist.empty() ? cpus : parse_cpulist(nodelist)) {
+		if(std::binary_search(cpus.begin(), cpus.end(), cpu)) {
+		    nodecpus.push_back(cpu);
+		}
+	    }
+	    if(!nodecpus.empty()) {
+		m_slots.push_back(nodecpus);
+		m_slotnames.push_back( "node" + std::to_string(node) );
+	    }
+	}
+	break;
+    }
+
+    case Policy::list:
+	for(auto &slot: m_slots) {
+	    if(!std::binary_search(cpus.begin(), cpus.end(), slot.front())) {
+		throw std::invalid_argument("CPU " + std::to_string(slot.front()) + " is not available to the process");
+	    }
+	}
+	break;
+
+    default:
+	break;
+    }
+
+    if(m_slots.empty()) {
+	throw std::invalid_argument("cannot determine CPU placement for policy " + policy);
+    }
+#endif
+}
+
+
+std::string CpuAffinity::placement(const std::vector<std::size_t> &threads) const
+{
+    if(m_slots.empty()) {
+	return "unbound";
+    }
+
+    std::string rv;
+    for(auto th: threads) {
+	rv += (rv.empty() ? "" : ",") + m_slotnames[th % m_slotnames.size()];
+    }
+    return rv;
+}
+
+
+bool CpuAffinity::bind(std::size_t threadindex) const
+{
+    if(m_slots.empty()) {
+	return true;		// nothing to do
+    }
+
+#if defined(HAVE_PTHREAD_SETAFFINITY_NP)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for(auto cpu: m_slots[threadindex % m_slots.size()]) {
+	CPU_SET(cpu, &mask);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,69 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// cpuaffinity.hpp: placement of benchmark threads on CPUs and NUMA nodes
+//
+// The following policies are supported:
+//  - none:    threads are left to the scheduler (default)
+//  - compact: threads are packed on the CPUs of a core, then of a socket, before moving to the next one
+//  - scatter: threads are spread across sockets first, then across physical cores, hyperthreads last
+//  - numa:    threads are distributed round-robin across NUMA nodes, and may float on the CPUs of their node
+//  - a list of CPUs, e.g. 0,2,4-7: thread #i is pinned to the i-th CPU of the list
+// When there are more threads than slots, assignment wraps around.
+
+#if !defined(CPUAFFINITY_H)
+#define CPUAFFINITY_H
+
+#include <string>
+#include <vector>
+
+class CpuAffinity
+{
+public:
+    enum class Policy {
+	none,
+	compact,
+	scatter,
+	numa,
+	list
+    };
+
+    // constructor: throws std::invalid_argument if the policy cannot be understood
+    CpuAffinity(std::string policy);
+
+    static auto choices() { return std::string("none, compact, scatter, numa, or a list of CPUs (e.g. 0,2,4-7)"); }
+
+    inline Policy policy() const { return m_policy; }
+    inline std::string name() const { return m_name; }
+
+    // placement(): describe where the given threads are placed, e.g. "cpu0,cpu2" or "node0,node1"
+    std::string placement(const std::vector<std::size_t> &threads) const;
+
+    // bind(): bind the calling thread to the slot matching its index.
+    // Memory allocated afterwards by the thread is first touched from there, i.e. on its local NUMA node.
+    // returns false when the binding could not be applied.
+    bool bind(std::size_t threadindex) const;
+
+private:
+    Policy m_policy { Policy::none };
+    std::string m_name;
+    std::vector<std::vector<int> > m_slots; // CPU sets to bind to, assigned round-robin to threads
+    std::vector<std::string> m_slotnames;
+};
+
+#endif // CPUAFFINITY_H
@@ -0,0 +1,129 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// datapointwriter.cpp: stream the datapoints of all threads to a file, while test cases run
+//
+// The CSV format has a header line, then one line per datapoint.
+// The binary format starts with the magic "P11DP001", followed by records in native byte order:
+//  - a run, as 'R', its index (uint32), the length (uint32) and characters of its name,
+//  - a datapoint, as 'D', then the fields of Datapoint: start, latency (double), session (uint64), thread, outcome (uint32).
+
+#include <chrono>
+#include <stdexcept>
+#include "datapointwriter.hpp"
+
+DatapointWriter::DatapointWriter(const std::string &path, Format format, size_t workers, size_t capacity)
+    : m_out(path, std::ios::out | std::ios::trunc | std::ios::binary), m_format(format)
+{
+    if(!m_out) {
+	throw std::runtime_error("cannot open datapoints file " + path);
+    }
+
+    for(size_t i=0; i<workers; i++) {
+	m_rings.emplace_back(new SpscRing<Datapoint>(capacity));
+    }
+
+    if(m_format == Format::csv) {
+	m_out << "run,testcase,thread,session,start_ms,latency_ms,outcome\n";
+    } else {
+	m_out.write("P11DP001", 8);
+    }
+
+    // the writer polls the rings; when they are all empty, it sleeps for a while
+    m_writer = std::thread( [this] {
+	while(!m_stop.load(std::memory_order_acquire)) {
+	    size_t written;
+	    {
+		std::lock_guard<std::mutex> lg{m_mtx};
+		written = drain();
+	    }
+	    if(written == 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	    }
+	}
+    });
+}
+
+DatapointWriter::~DatapointWriter()
+{
+    m_stop.store(true, std::memory_order_release);
+    m_writer.join();
+    std::lock_guard<std::mutex> lg{m_mtx};
+    drain();
+    m_out.flush();
+}
+
+size_t DatapointWriter::drain()
+{
+    size_t count = 0;
+    Datapoint datapoint;
+    for(auto &ring: m_rings) {
+	while(ring->try_pop(datapoint)) {
+	    write(datapoint);
+	    count++;
+	}
+    }
+    return count;
+}
+
+void DatapointWriter::write(const Datapoint &datapoint)
+{
+    if(m_format == Format::csv) {
+	m_out << m_run << ',' << m_csvname << ',' << datapoint.thread << ',' << datapoint.session << ','
+	      << datapoint.start << ',' << datapoint.latency << ',' << datapoint.outcome << '\n';
+    } else {
+	m_out.put('D');
+	m_out.write(reinterpret_cast<const char *>(&datapoint.start), sizeof datapoint.start);
+	m_out.write(reinterpret_cast<const char *>(&datapoint.latency), sizeof datapoint.latency);
+	m_out.write(reinterpret_cast<const char *>(&datapoint.session), sizeof datapoint.session);
+	m_out.write(reinterpret_cast<const char *>(&datapoint.thread), sizeof datapoint.thread);
+	m_out.write(reinterpret_cast<const char *>(&datapoint.outcome), sizeof datapoint.outcome);
+    }
+}
+
+void DatapointWriter::begin(const std::string &name)
+{
+    std::lock_guard<std::mutex> lg{m_mtx};
+    drain();
+
+    m_run++;
+    m_name = name;
+    // names may hold commas (e.g. mixed workloads): the CSV field is quoted, and its quotes doubled
+    m_csvname = "\"";
+    for(auto c: m_name) {
+	m_csvname += c == '"' ? std::string(2, c) : std::string(1, c);
+    }
+    m_csvname += '"';
+    if(m_format == Format::binary) {
+	uint32_t length = m_name.size();
+	m_out.put('R');
+	m_out.write(reinterpret_cast<const char *>(&m_run), sizeof m_run);
+	m_out.write(reinterpret_cast<const char *>(&length), sizeof length);
+	m_out.write(m_name.data(), length);
+    }
+}
+
+std::optional<DatapointWriter::Format> DatapointWriter::parse(const std::string &name)
+{
+    if(name == "csv") {
+	return Format::csv;
+    } else if(name == "binary") {
+	return Format::binary;
+    }
+    return std::nullopt;
+}
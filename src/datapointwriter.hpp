@@ -0,0 +1,93 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// datapointwriter.hpp: stream the datapoints of all threads to a file, while test cases run
+//
+// Each worker thread pushes its datapoints into its own ring, drained by a writer thread,
+// so the measured loop never waits for I/O. When a ring is full, the datapoint is dropped and counted.
+
+#if !defined(DATAPOINTWRITER_H)
+#define DATAPOINTWRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include "spscring.hpp"
+
+// a single operation, as streamed
+struct Datapoint {
+    double start;		// start of the operation, in ms from the origin of the run
+    double latency;		// in ms
+    uint64_t session;		// handle of the session the operation ran on
+    uint32_t thread;		// global index of the thread
+    uint32_t outcome;		// PKCS#11 return value, 0 (CKR_OK) when the operation succeeded
+};
+
+// sink of a worker thread: its ring, and its index in the stream
+struct DatapointSink {
+    SpscRing<Datapoint> *ring;
+    uint32_t thread;
+};
+
+class DatapointWriter
+{
+public:
+    enum class Format { csv, binary };
+
+private:
+    std::ofstream m_out;
+    Format m_format;
+    std::vector<std::unique_ptr<SpscRing<Datapoint> > > m_rings; // one per worker thread
+    std::mutex m_mtx;		// held while draining, and while switching runs
+    uint32_t m_run {0};		// index of the current run, from 1
+    std::string m_name;		// name of the current run
+    std::string m_csvname;	// name of the current run, as a quoted CSV field
+    std::atomic<bool> m_stop {false};
+    std::thread m_writer;
+
+    // drain(): write the datapoints found in all rings, returns how many. Must be called with m_mtx held.
+    size_t drain();
+
+    void write(const Datapoint &datapoint);
+
+public:
+    DatapointWriter(const std::string &path, Format format, size_t workers, size_t capacity = 16384);
+    ~DatapointWriter();
+
+    DatapointWriter( const DatapointWriter &) = delete;
+    DatapointWriter& operator=( const DatapointWriter &) = delete;
+
+    // sink(): the sink of a worker thread, streamed as the given thread index
+    inline DatapointSink sink(size_t worker, uint32_t thread) { return DatapointSink { m_rings.at(worker).get(), thread }; }
+
+    // begin(): start a new run, named after its test case. Datapoints pushed before belong to the previous run,
+    // and are written first: this must be called while worker threads are idle.
+    void begin(const std::string &name);
+
+    // parse(): retrieve a format from its name, csv or binary
+    static std::optional<Format> parse(const std::string &name);
+};
+
+
+#endif // DATAPOINTWRITER_H
@@ -21,13 +21,6 @@
 
 static const std::string _errorcode(int rc);
 
-// overloaded is needed for std::visit
-
-template<class... Ts>
-struct overloaded : Ts... { using Ts::operator()...; };
-template<class... Ts>
-overloaded(Ts...) -> overloaded<Ts...>;
-
 
 const std::string errorcode(benchmark_result::operation_outcome_t outcome) {
     return std::visit( 
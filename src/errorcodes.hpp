@@ -23,6 +23,13 @@
 #include "../config.h"
 #include "p11benchmark.hpp"
 
+// overloaded is needed for std::visit
+
+template<class... Ts>
+struct overloaded : Ts... { using Ts::operator()...; };
+template<class... Ts>
+overloaded(Ts...) -> overloaded<Ts...>;
+
 const std::string errorcode(benchmark_result::operation_outcome_t outcome);
 
 
@@ -24,8 +24,6 @@
 #include <algorithm>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <future>
 #include <functional>
 #include <variant>
 #include <utility>
@@ -35,374 +33,1013 @@
 #include <chrono>
 #include <ratio>
 #include <cmath>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/count.hpp>
-#include <boost/accumulators/statistics/variance.hpp>
-#include <boost/accumulators/statistics/tail_quantile.hpp>
+#include <limits>
+#include <map>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
 #include "ConsoleTable.h"
 #include "errorcodes.hpp"
 #include "p11benchmark.hpp"
 #include "measure.hpp"
+#include "scalability.hpp"
+#include "warmup.hpp"
+#include "histogram.hpp"
+#include "statistics.hpp"
+#include "bootstrap.hpp"
+#include "timer.hpp"
 #include "executor.hpp"
 
+namespace {
+    // helper functions for ConsoleTable conversion of items to string
+    std::string d2s(double arg, int precision=-1)
+    {
+	std::ostringstream stream;
+	if(precision>=0) stream << std::setprecision(precision);
+	stream << arg;
+	return stream.str();
+    }
 
-// thread sync objects
-std::mutex greenlight_mtx;
-std::condition_variable greenlight_cond;
-bool greenlight = false;
+    std::string i2s(long arg)
+    {
+	std::ostringstream stream;
+	stream << arg;
+	return stream.str();
+    }
 
-namespace bacc = boost::accumulators;
+    // sparkline(): draw values as a line of bars, scaled from 0 to the largest value.
+    // When there are more values than width, consecutive values are averaged.
+    std::string sparkline(const std::vector<double> &values, size_t width = 72)
+    {
+	static const char *bars[] = { " ", "\u2581", "\u2582", "\u2583", "\u2584", "\u2585", "\u2586", "\u2587", "\u2588" };
 
+	const size_t group = (values.size() + width - 1) / width;
+	std::vector<double> points;
+	for(size_t i=0; i<values.size(); i+=group) {
+	    auto last = std::min(values.size(), i + group);
+	    double sum = 0.0;
+	    for(size_t j=i; j<last; j++) {
+		sum += values[j];
+	    }
+	    points.push_back(sum / (last - i));
+	}
 
-ptree Executor::benchmark( P11Benchmark &benchmark, const size_t iter, const size_t skipiter, const std::forward_list<std::string> shortlist )
-{
+	double top = 0.0;
+	for(auto point: points) {
+	    top = std::max(top, point);
+	}
 
-    ptree rv;
+	std::string line;
+	for(auto point: points) {
+	    line += bars[top > 0 ? static_cast<size_t>(std::round(8 * point / top)) : 0];
+	}
+	return line;
+    }
 
-    for(auto testcase: shortlist) {
-	size_t th;
-	std::vector<benchmark_result::benchmark_result_t> elapsed_time_array(m_numthreads);
-	std::vector<std::future<benchmark_result::benchmark_result_t> > future_array(m_numthreads);
-	std::vector<P11Benchmark *> benchmark_array(m_numthreads);
-	benchmark_result::operation_outcome_t last_errcode = benchmark_result::Ok{};
-
-	
-	milliseconds_double_t wallclock_elapsed { 0 }; // used to measure how much time in total was spent in executing the test
-
-	// helper functions for ConsoleTable conversion of items to string
-	auto d2s = [] (double arg, int precision=-1) -> std::string {
-	    std::ostringstream stream;
-	    if(precision>=0) stream << std::setprecision(precision);
-	    stream << arg;
-	    return stream.str();
-	};
+    // serialization of measurements, to transfer them from worker processes to their parent.
+    // Both ends run the same binary, so the native representation is used.
+    template<typename T>
+    void put(std::string &out, const T &value)
+    {
+	out.append(reinterpret_cast<const char *>(&value), sizeof value);
+    }
 
-	auto i2s = [] (long arg) -> std::string {
-	    std::ostringstream stream;
-	    stream << arg;
-	    return stream.str();
-	};
+    void put(std::string &out, const std::string &value)
+    {
+	put(out, static_cast<uint64_t>(value.size()));
+	out.append(value);
+    }
 
-	std::vector<std::tuple<std::string, std::string, std::string>> fact_rows {
-	    { "algorithm", "algorithm", benchmark.name() },
-	    { "vector size", "vector.size", i2s(m_vectors.at(testcase).size()) },
-	    { "vector unit", "vector.unit", "Byte" },
-	    { "key label", "label", benchmark.label() },
-	    { "number of threads", "threads", i2s(m_numthreads) },
-	    { "iterations/thread", "iterations", i2s(iter) },
-	    { "skipped iterarions/thread", "iterations", i2s(skipiter) },
-	    { "total of iterations", "total iterations", i2s(iter*m_numthreads) }
-	};
+    template<typename T>
+    void get(const std::string &in, size_t &pos, T &value)
+    {
+	if(pos + sizeof value > in.size()) {
+	    throw std::runtime_error("malformed record from worker process");
+	}
+	std::copy(in.data() + pos, in.data() + pos + sizeof value, reinterpret_cast<char *>(&value));
+	pos += sizeof value;
+    }
 
-	std::vector<std::tuple<std::string, std::string, Measure<>>> result_rows;
+    void get(const std::string &in, size_t &pos, std::string &value)
+    {
+	uint64_t len;
+	get(in, pos, len);
+	if(pos + len > in.size()) {
+	    throw std::runtime_error("malformed record from worker process");
+	}
+	value.assign(in, pos, len);
+	pos += len;
+    }
 
-	ConsoleTable facts { "property", "value" };
-	facts.setStyle(1);
+    void put(std::string &out, const RecordBuffer<milliseconds_double_t> &records)
+    {
+	put(out, static_cast<uint64_t>(records.size()));
+	for(auto &it: records) {
+	    put(out, it.count());
+	}
+    }
 
-	for(auto &row: fact_rows) {
-	    facts += { std::get<0>(row), std::get<2>(row) };
+    void get(const std::string &in, size_t &pos, RecordBuffer<milliseconds_double_t> &records)
+    {
+	uint64_t count;
+	get(in, pos, count);
+	for(uint64_t i=0; i<count; i++) {
+	    double value;
+	    get(in, pos, value);
+	    records.push_back(milliseconds_double_t{value});
 	}
+    }
 
-	std::cout << benchmark.name() + " with key " + benchmark.label() << '\n'
-		  << "================================================================================\n"
-		  << "Test case facts:\n"
-		  << facts << std::endl;
+    // histograms are sent in their serialized form, empty when there is none
+    void put(std::string &out, const std::optional<Histogram> &histogram)
+    {
+	std::vector<uint64_t> serialized;
+	if(histogram) {
+	    histogram->serialize(serialized);
+	}
+	put(out, static_cast<uint64_t>(serialized.size()));
+	for(auto it: serialized) {
+	    put(out, it);
+	}
+    }
 
-	greenlight = false;	// prepare threads to sync on "green light"
+    void get(const std::string &in, size_t &pos, std::optional<Histogram> &histogram)
+    {
+	uint64_t count;
+	get(in, pos, count);
+	if(count == 0) {
+	    histogram.reset();
+	    return;
+	}
+	std::vector<uint64_t> serialized(count);
+	for(auto &it: serialized) {
+	    get(in, pos, it);
+	}
+	histogram = Histogram::deserialize(serialized);
+    }
 
-	for(th=0; th<m_numthreads;th++) {
-	    // make a copy of the benchmark object, for each thread
-	    benchmark_array[th] = benchmark.clone(); // get a "clone" of the object
+    void put(std::string &out, const benchmark_result::operation_outcome_t &outcome)
+    {
+	put(out, static_cast<uint64_t>(outcome.index()));
+	std::visit( overloaded {
+		[&](benchmark_result::Ok) { },
+		[&](benchmark_result::ApiErr const& apiErr) { put(out, static_cast<int64_t>(apiErr)); },
+		[&](benchmark_result::NotFound const& nf) { put(out, nf.label()); },
+		[&](benchmark_result::AmbiguousResult const& ar) { put(out, ar.label()); },
+		[&](benchmark_result::PayloadSizeNotSupported const& psns) { put(out, static_cast<uint64_t>(psns.size())); }
+	    }, outcome );
+    }
 
-	    if(m_generate_session_keys) {
-		future_array[th] = std::async( std::launch::async,
-					       &P11Benchmark::execute,
-					       benchmark_array[th],
-					       m_sessions[th].get(),
-					       m_vectors.at(testcase),
-					       iter,
-					       skipiter,
-					       std::optional<size_t>(th));
+    void get(const std::string &in, size_t &pos, benchmark_result::operation_outcome_t &outcome)
+    {
+	uint64_t index;
+	get(in, pos, index);
+
+	if(index == 0) {
+	    outcome = benchmark_result::Ok{};
+	} else if(index == 1) {
+	    int64_t apiErr;
+	    get(in, pos, apiErr);
+	    outcome = static_cast<benchmark_result::ApiErr>(apiErr);
+	} else if(index == 2 || index == 3) {
+	    std::string label;
+	    get(in, pos, label);
+	    if(index == 2) {
+		outcome = benchmark_result::NotFound(label);
 	    } else {
-		future_array[th] = std::async( std::launch::async,
-					       &P11Benchmark::execute,
-					       benchmark_array[th],
-					       m_sessions[th].get(),
-					       m_vectors.at(testcase),
-					       iter,
-					       skipiter,
-					       std::nullopt);
-	    }
-	}
-
-	// start the wall clock
-
-	auto wallclock_1 = std::chrono::steady_clock::now();
-	// give start signal
-	{
-	    std::lock_guard<std::mutex> greenlight_lck(greenlight_mtx);
-	    greenlight = true;
-	    greenlight_cond.notify_all();
-	}
-
-	// recover futures
-	for(th=0;th<m_numthreads;th++) {
-	    elapsed_time_array[th] = future_array[th].get();
-	}
-
-	// stop wallclock and measure elapsed time
-	auto wallclock_2 = std::chrono::steady_clock::now();
-	wallclock_elapsed = std::chrono::duration_cast<milliseconds_double_t>(wallclock_2 - wallclock_1);
-
-	// We need to adjust the cache size so it can hold at least 5% of the entire sample
-	// the sample size = # of threads x # of iterations per thread
-	size_t required_cache_size = static_cast<size_t>(std::ceil(0.05 * static_cast<double>(m_numthreads * iter)))+ 10;
-
-	// we create one accumulator for most of the stats
-	bacc::accumulator_set< double, bacc::stats<
-	    bacc::tag::mean,
-	    bacc::tag::min,
-	    bacc::tag::max,
-	    bacc::tag::count,
-	    bacc::tag::variance,
-	    bacc::tag::tail_quantile< bacc::right >
-	    > > acc( bacc::tag::tail<bacc::right>::cache_size = required_cache_size );
-
-	// and one for stats vs log-normal distribution
-	bacc::accumulator_set< double, bacc::stats<
-	    bacc::tag::mean,
-	    bacc::tag::variance,
-	    bacc::tag::count
-	    > > acc_log;
-
-	// Flag to track if we're using log1p (for small values) or log
-	bool use_log1p = false;
-
-	// Kolmogorov-Smirnov goodness-of-fit test function
-	auto kolmogorov_smirnov_gof = [](const std::vector<benchmark_result::benchmark_result_t>& elapsed_array, 
-	                                 bool use_log) -> double {
-	    // First, calculate the mean to decide log vs log1p
-	    double sum_raw = 0.0;
-	    size_t count = 0;
-	    for(const auto& elapsed : elapsed_array) {
-		// Only consider successful measurements
-		if(std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
-		    for(const auto& it : elapsed.first) {
-			sum_raw += it.count();
-			count++;
-		    }
-		}
+		outcome = benchmark_result::AmbiguousResult(label);
 	    }
-	    bool use_log1p_local = use_log && (count > 0) && (sum_raw / count < 1.0);
-
-	    // Collect data
-	    std::vector<double> data;
-	    for(const auto& elapsed : elapsed_array) {
-		if(std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
-		    for(const auto& it : elapsed.first) {
-			double val = it.count();
-			if (use_log) {
-			    data.push_back(use_log1p_local ? std::log1p(val) : std::log(val));
-			} else {
-			    data.push_back(val);
-			}
-		    }
-		}
+	} else if(index == 4) {
+	    uint64_t size;
+	    get(in, pos, size);
+	    outcome = benchmark_result::PayloadSizeNotSupported(size);
+	} else {
+	    throw std::runtime_error("malformed record from worker process");
+	}
+    }
+
+    std::string encode(const std::string &name, const std::string &label, const std::string &testcase, const Measurement &measurement)
+    {
+	std::string out;
+	put(out, name);
+	put(out, label);
+	put(out, testcase);
+	put(out, measurement.wallclock.count());
+	put(out, static_cast<uint64_t>(measurement.operations.size()));
+	for(auto &operation: measurement.operations) {
+	    put(out, operation);
+	}
+	put(out, static_cast<uint64_t>(measurement.results.size()));
+	for(size_t th=0; th<measurement.results.size(); th++) {
+	    auto &result = measurement.results[th];
+	    put(out, static_cast<uint64_t>(measurement.threads[th]));
+	    put(out, result.second);
+	    put(out, result.first.latency);
+	    put(out, result.first.timestamp);
+	    put(out, result.first.completion);
+	    put(out, result.first.response);
+	    put(out, static_cast<uint64_t>(result.first.missed));
+	    put(out, result.first.checkout);
+	    put(out, result.first.histogram);
+	    put(out, static_cast<uint64_t>(result.first.dropped));
+	    put(out, result.first.init);
+	    put(out, result.first.cleanup);
+	    put(out, static_cast<uint64_t>(result.first.operation.size()));
+	    for(auto &it: result.first.operation) {
+		put(out, it);
 	    }
-		
-	    if (data.empty()) return 0.0;
-		
-	    size_t n = data.size();
-		
-	    // Calculate mean and stddev directly from data
-	    double sum = 0.0;
-	    for (double val : data) sum += val;
-	    double mean = sum / n;
-		
-	    double sum_sq = 0.0;
-	    for (double val : data) {
-		double diff = val - mean;
-		sum_sq += diff * diff;
-	    }
-	    double variance = sum_sq / (n - 1);  // Sample variance
-	    double stddev = std::sqrt(variance);
-		
-	    // Sort data for KS test
-	    std::sort(data.begin(), data.end());
-		
-	    // Standard normal CDF: Φ(x) = 0.5 * (1 + erf((x - μ) / (σ * √2)))
-	    auto norm_cdf = [mean, stddev](double x) {
-		return 0.5 * (1.0 + std::erf((x - mean) / (stddev * std::sqrt(2.0))));
-	    };
-		
-	    // Calculate Kolmogorov-Smirnov statistic
-	    // D = max|F(x) - F_n(x)| where F_n is the empirical CDF
-	    double D = 0.0;
-	    for (size_t i = 0; i < n; ++i) {
-		double F_theoretical = norm_cdf(data[i]);
-		double F_empirical_before = static_cast<double>(i) / n;
-		double F_empirical_after = static_cast<double>(i + 1) / n;
-			
-		// KS statistic is the maximum absolute difference
-		double diff_before = std::abs(F_theoretical - F_empirical_before);
-		double diff_after = std::abs(F_theoretical - F_empirical_after);
-		D = std::max(D, std::max(diff_before, diff_after));
-	    }
-		
-	    return D;
-	};
+	}
+	return out;
+    }
 
-	// helper map table for statistics
-	std::map<std::string, std::function<double()> > stats {
-	    { "min",   [&acc] () { return bacc::min(acc);  }},
-	    { "mean",  [&acc] () { return bacc::mean(acc); }},
-	    { "max",   [&acc] () { return bacc::max(acc);  }},
-	    { "range", [&acc] () { return (bacc::max(acc) - bacc::min(acc)); }},
-	    { "svar",   [&acc] () {
-		auto n = bacc::count(acc);
-		double f = static_cast<double>(n) / (n - 1);
-		return f * bacc::variance(acc); }},
-	    { "sstddev", [&stats] () { return std::sqrt(stats["svar"]()); }},
-	    // note: for error, we take k=2 so 95% of measures are within interval
-	    { "error", [&stats] () { return std::sqrt(stats["svar"]()/static_cast<double>( stats["count"]() ))*2; }},
-	    { "count", [&acc] () { return bacc::count(acc); }},
-	    { "p95", [&acc] () { return bacc::quantile(acc, bacc::quantile_probability = 0.95); }},
-	    { "p98", [&acc] () { return bacc::quantile(acc, bacc::quantile_probability = 0.98); }},
-	    { "p99", [&acc] () { return bacc::quantile(acc, bacc::quantile_probability = 0.99); }},
-	    { "logavg", [&acc_log, &use_log1p] () {
-		auto n = bacc::count(acc_log);
-		if (use_log1p) {
-		    return std::expm1( bacc::mean(acc_log) );  // exp(x)-1 for log1p case
-		} else {
-		    return std::exp( bacc::mean(acc_log) );
-		}
-	    }},
-	    { "logsvar",   [&acc_log, &use_log1p] () {
-		auto n = bacc::count(acc_log);
-		double f = static_cast<double>(n) / (n - 1);
-		if (use_log1p) {
-		    return std::expm1( f * bacc::variance(acc_log) );
-		} else {
-		    return std::exp( f * bacc::variance(acc_log) );
+    // percentile_name(): ordinal and key of a percentile given in percent, e.g. "99.9th" and "999" for 99.9
+    std::pair<std::string, std::string> percentile_name(double pct)
+    {
+	std::ostringstream os;
+	os << pct;
+	auto number = os.str();
+	auto key = number;
+	key.erase(std::remove(key.begin(), key.end(), '.'), key.end());
+
+	std::string suffix { "th" };
+	if(number.find('.') == std::string::npos) {
+	    auto n = std::stoi(number) % 100;
+	    if(n < 11 || n > 13) {
+		suffix = n % 10 == 1 ? "st" : n % 10 == 2 ? "nd" : n % 10 == 3 ? "rd" : "th";
+	    }
+	}
+	return { number + suffix, key };
+    }
+
+    // latency_summary(): average and 99th percentile of the latency, over all threads of a measurement
+    std::pair<double, double> latency_summary(const Measurement &measurement)
+    {
+	// in histogram mode, the histograms of all threads are merged instead
+	if(!measurement.results.empty() && measurement.results.front().first.histogram) {
+	    Histogram merged { measurement.results.front().first.histogram->digits() };
+	    for(auto &result: measurement.results) {
+		if(result.first.histogram) {
+		    merged.merge(*result.first.histogram);
 		}
-	    }},
-	    { "logsstdev", [&stats] () { return std::sqrt(stats["logsvar"]()); }},
-	    { "logerror", [&stats] () { return std::sqrt(stats["logsvar"]()/static_cast<double>( stats["count"]() ))*2; }},
-	    // Kolmogorov-Smirnov goodness-of-fit tests
-	    { "ks_normal", [&kolmogorov_smirnov_gof, &elapsed_time_array] () {
-		return kolmogorov_smirnov_gof(elapsed_time_array, false);
-	    }},
-	    { "ks_lognormal", [&kolmogorov_smirnov_gof, &elapsed_time_array] () {
-		return kolmogorov_smirnov_gof(elapsed_time_array, true);
-	    }}
-	};
+	    }
+	    return { merged.mean(), merged.percentile(0.99) };
+	}
 
-	// compute statistics
-	// First pass: compute regular statistics to determine if we need log1p
-	for(auto elapsed: elapsed_time_array) {
-	    if(!std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
-		last_errcode = elapsed.second;
-		wallclock_elapsed = milliseconds_double_t { 0 };
-		break;		// something wrong happened, no need to carry on
+	std::vector<double> latencies;
+	for(auto &result: measurement.results) {
+	    for(auto &it: result.first.latency) {
+		latencies.push_back(it.count());
 	    }
+	}
+	const SampleStatistics sample { std::move(latencies) };
+	return { sample.mean(), sample.percentile(0.99) };
+    }
 
-	    for(auto &it: elapsed.first) {
-		double val = it.count();
-		acc(val);
+    // relative_errors(): relative error on the average latency, and relative half-width of the 95% confidence interval
+    // of the 99th percentile, over all threads of a measurement. The error on the average is at least epsilon (ms).
+    // The confidence interval of the percentile is made of the order statistics around it, whatever the distribution;
+    // it is infinite as long as the sample is too small for its upper bound to exist.
+    std::pair<double, double> relative_errors(const Measurement &measurement, double epsilon)
+    {
+	std::vector<double> latencies;
+	for(auto &result: measurement.results) {
+	    for(auto &it: result.first.latency) {
+		latencies.push_back(it.count());
 	    }
 	}
+	const SampleStatistics sample { std::move(latencies) };
 
-	// Check if average is small (< 1.0), if so use log1p for better numerical stability
-	use_log1p = (bacc::count(acc) > 0) && (bacc::mean(acc) < 1.0);
+	const auto infinity = std::numeric_limits<double>::infinity();
+	const double n = sample.count();
+	if(n < 2) {
+	    return { infinity, infinity };
+	}
 
-	// Second pass: compute log statistics with appropriate transformation
-	for(auto elapsed: elapsed_time_array) {
-	    if(!std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
-		break;		// something wrong happened, no need to carry on
+	auto error = std::max(std::sqrt( sample.variance() / n ) * 2, epsilon);
+
+	const double p = 0.99, z = 1.96;
+	auto spread = z * std::sqrt(n * p * (1 - p));
+	auto lo = std::floor(n * p - spread), hi = std::ceil(n * p + spread);
+	if(lo < 1 || hi > n) {
+	    return { error / sample.mean(), infinity };
+	}
+	auto p99 = sample.percentile(p);
+	auto halfwidth = (sample.at(static_cast<size_t>(hi)) - sample.at(static_cast<size_t>(lo))) / 2;
+
+	return { error / sample.mean(), std::max(halfwidth, epsilon) / p99 };
+    }
+
+    // trim(): drop the first records of a buffer
+    template<typename T>
+    void trim(RecordBuffer<T> &records, size_t count)
+    {
+	if(count == 0 || records.empty()) {
+	    return;
+	}
+	RecordBuffer<T> kept;
+	for(size_t i=count; i<records.size(); i++) {
+	    kept.push_back(records[i]);
+	}
+	records = std::move(kept);
+    }
+
+    // trim(): drop the records of the first operations of a thread
+    void trim(benchmark_result::datapoints_t &datapoints, size_t count)
+    {
+	trim(datapoints.latency, count);
+	trim(datapoints.timestamp, count);
+	trim(datapoints.completion, count);
+	trim(datapoints.response, count);
+	trim(datapoints.checkout, count);
+	trim(datapoints.operation, count);
+	trim(datapoints.init, count);
+	trim(datapoints.cleanup, count);
+    }
+
+    void decode(const std::string &in, std::string &name, std::string &label, std::string &testcase, Measurement &measurement)
+    {
+	size_t pos = 0;
+	double wallclock;
+	uint64_t count;
+	get(in, pos, name);
+	get(in, pos, label);
+	get(in, pos, testcase);
+	get(in, pos, wallclock);
+	measurement.wallclock = milliseconds_double_t{wallclock};
+	get(in, pos, count);
+	measurement.operations.resize(count);
+	for(auto &operation: measurement.operations) {
+	    get(in, pos, operation);
+	}
+	get(in, pos, count);
+	measurement.results.resize(count);
+	for(auto &result: measurement.results) {
+	    uint64_t thread, missed;
+	    get(in, pos, thread);
+	    measurement.threads.push_back(thread);
+	    get(in, pos, result.second);
+	    get(in, pos, result.first.latency);
+	    get(in, pos, result.first.timestamp);
+	    get(in, pos, result.first.completion);
+	    get(in, pos, result.first.response);
+	    get(in, pos, missed);
+	    result.first.missed = missed;
+	    get(in, pos, result.first.checkout);
+	    get(in, pos, result.first.histogram);
+	    uint64_t dropped;
+	    get(in, pos, dropped);
+	    result.first.dropped = dropped;
+	    get(in, pos, result.first.init);
+	    get(in, pos, result.first.cleanup);
+	    get(in, pos, count);
+	    for(uint64_t i=0; i<count; i++) {
+		uint32_t operation;
+		get(in, pos, operation);
+		result.first.operation.push_back(operation);
 	    }
+	}
+    }
+}
 
-	    for(auto &it: elapsed.first) {
-		double val = it.count();
-		if (use_log1p) {
-		    acc_log(std::log1p(val));  // log(1+x) for small values
-		} else {
-		    acc_log(std::log(val));     // log(x) for normal values
-		}
+
+void Executor::place_threads()
+{
+    // workers are bound once and for all, before they allocate anything:
+    // buffers later allocated by the benchmark clones are therefore first touched on the local node.
+    std::mutex mtx;
+    m_pool.run( [&](size_t th) {
+	if(!m_options.affinity.bind(client_index(th))) {
+	    std::lock_guard<std::mutex> lg{mtx};
+	    std::cerr << "*** Warning: could not bind thread #" << th << " according to CPU affinity policy '" << m_options.affinity.name() << "'\n";
+	}
+    });
+}
+
+Measurement Executor::measure( const std::vector<P11Benchmark *> &clones, const std::string &testcase, const size_t iter, const size_t skipiter, const size_t batch )
+{
+    Measurement measurement;
+
+    const size_t numprocesses = m_options.processes ? m_options.processes->size() : 1;
+
+    // results are kept in worker order, idle workers aside
+    std::vector<size_t> workers;
+    for(size_t th=0; th<clones.size(); th++) {
+	if(clones[th]) {
+	    workers.push_back(th);
+	    measurement.threads.push_back(client_index(th));
+	}
+    }
+    const size_t numthreads = workers.size();
+    measurement.results.resize(numthreads);
+    measurement.operations = clones[workers.front()]->operations();
+
+    // each run is a section of the datapoint stream, named after its benchmark (as in results), test vector and
+    // number of threads (across worker processes), and for adaptive runs, its batch
+    if(m_options.stream) {
+	auto benchmark = clones[workers.front()];
+	auto clients = numthreads / m_options.queuedepth * (m_options.processes ? m_options.processes->size() : 1);
+	m_options.stream->begin(benchmark->name() + " using " + benchmark->label() + '.' + testcase + '.' + i2s(clients) + " thread-s"
+			+ (batch ? ".batch " + i2s(batch) : ""));
+    }
+
+    // each worker thread runs the test case with its own clone of the benchmark, on its own session,
+    // or on sessions checked out from the pool of its slot.
+    // All workers meet at the start barrier once prepared; its release time starts the wall clock.
+    m_start.reset(numthreads);
+    m_pool.run( [&](size_t th) {
+	if(!clones[th]) {
+	    return;
+	}
+	const size_t rank = std::find(workers.begin(), workers.end(), th) - workers.begin();
+
+	// in open-loop mode, the arrivals are dealt to threads (of all processes) in turn:
+	// at a constant rate, each thread fires every numthreads/m_options.rate seconds, and threads are interleaved
+	const size_t stride = numprocesses * numthreads;
+	const size_t first = global_index(rank);
+	RunOptions options;
+	if(m_options.rate > 0) {
+	    options.pacing = Pacing { [=](size_t k) -> std::optional<nanoseconds_double_t> {
+		return std::chrono::duration<double>((first + k * stride) / m_options.rate);
+	    } };
+	} else if(m_options.profile && m_options.profile->unit() == LoadProfile::Unit::rate) {
+	    options.pacing = Pacing { [=, &profile = *m_options.profile](size_t k) -> std::optional<nanoseconds_double_t> {
+		auto due = profile.arrival(static_cast<double>(first + k * stride));
+		// a non-finite arrival cannot be converted to a time point: it ends the timetable instead
+		return due && std::isfinite(*due) ? std::optional<nanoseconds_double_t>(std::chrono::duration<double>(*due)) : std::nullopt;
+	    } };
+	} else if(m_options.profile) {
+	    // with a profile of threads, the first threads (of all processes) are the active ones
+	    options.activity = Activity { [=, &profile = *m_options.profile](nanoseconds_double_t t) -> std::optional<nanoseconds_double_t> {
+		auto next = profile.activation(first, std::chrono::duration<double>(t).count());
+		return next ? std::optional<nanoseconds_double_t>(std::chrono::duration<double>(*next)) : std::nullopt;
+	    } };
+	}
+
+	options.window = m_options.window;
+	options.pool = m_options.threadpools.empty() ? nullptr : m_options.threadpools[th];
+	options.histogram = m_options.histogram;
+	if(m_options.stream) {
+	    options.sink = m_options.stream->sink(th, client_index(th));
+	}
+	options.breakdown = m_options.breakdown;
+
+	measurement.results[rank] = clones[th]->execute( m_sessions[th].get(),
+							 m_vectors.at(testcase),
+							 iter,
+							 skipiter,
+							 m_options.generate_session_keys ? std::optional<size_t>(th) : std::nullopt,
+							 m_start,
+							 options );
+    }, clones.size());
+
+    auto wallclock_1 = m_start.release_time();
+    // stop wallclock and measure elapsed time
+    auto wallclock_2 = std::chrono::steady_clock::now();
+    measurement.wallclock = std::chrono::duration_cast<milliseconds_double_t>(wallclock_2 - wallclock_1);
+
+    return measurement;
+}
+
+Measurement Executor::sample( const std::vector<P11Benchmark *> &clones, const std::string &testcase, const size_t iter, const size_t skipiter )
+{
+    if(!m_options.target) {
+	return measure( clones, testcase, iter, skipiter );
+    }
+
+    auto epsilon = 2 * std::chrono::duration_cast<milliseconds_double_t>(m_timer_res + m_timer_res_err).count();
+
+    // done(): whether the run can stop, either because the target is reached, the maximum number
+    // of iterations is, or a thread failed (in which case more batches would not help)
+    auto done = [&](const Measurement &measurement) {
+	for(auto &result: measurement.results) {
+	    if(!std::holds_alternative<benchmark_result::Ok>(result.second)) {
+		return true;
+	    }
+	}
+	if(measurement.batches * iter >= m_options.target->maxiter) {
+	    return true;
+	}
+	auto [relerr, p99relerr] = relative_errors(measurement, epsilon);
+	return relerr <= m_options.target->relerr && (!m_options.target->p99 || p99relerr <= m_options.target->relerr);
+    };
+
+    // iterations are skipped in the first batch only. Records of the following batches are appended,
+    // their timestamps being shifted by the wall clock of the previous batches.
+    Measurement merged = measure( clones, testcase, iter, skipiter, 1 );
+    merged.batches = 1;
+
+    while(!done(merged)) {
+	auto batch = measure( clones, testcase, iter, 0, merged.batches + 1 );
+
+	for(size_t th=0; th<batch.results.size(); th++) {
+	    auto &from = batch.results[th].first;
+	    auto &to = merged.results[th].first;
+
+	    for(size_t i=0; i<from.latency.size(); i++) {
+		to.latency.push_back(from.latency[i]);
+		to.timestamp.push_back(from.timestamp[i] + merged.wallclock);
+		to.completion.push_back(from.completion[i] + merged.wallclock);
+	    }
+	    for(auto &it: from.response) {
+		to.response.push_back(it);
+	    }
+	    for(auto &it: from.checkout) {
+		to.checkout.push_back(it);
+	    }
+	    for(auto &it: from.operation) {
+		to.operation.push_back(it);
+	    }
+	    for(auto &it: from.init) {
+		to.init.push_back(it);
+	    }
+	    for(auto &it: from.cleanup) {
+		to.cleanup.push_back(it);
 	    }
+	    if(from.histogram && to.histogram) {
+		to.histogram->merge(*from.histogram);
+	    }
+	    to.missed += from.missed;
+	    to.dropped += from.dropped;
+	    merged.results[th].second = batch.results[th].second;
 	}
 
-	auto vector_size = m_vectors.at(testcase).size();
-	auto stats_count = stats["count"]();
+	merged.wallclock += batch.wallclock;
+	merged.batches++;
+    }
+
+    return merged;
+}
+
+double Executor::report( const std::string &name, const std::string &label, const std::string &testcase, const size_t iter, const size_t skipiter, Measurement &measurement, ptree &rv, const std::string &prefix )
+{
+    auto &elapsed_time_array = measurement.results;
+    const int numthreads = elapsed_time_array.size(); // number of lanes, i.e. of threads when the queue depth is 1
+    benchmark_result::operation_outcome_t last_errcode = benchmark_result::Ok{};
+
+    milliseconds_double_t wallclock_elapsed { measurement.wallclock }; // used to measure how much time in total was spent in executing the test
+
+    // automatic warm-up detection: the transient found at the start of each thread is trimmed,
+    // before any statistics are computed. Its latencies are kept apart, to compare them with the steady state.
+    std::vector<double> cold;
+    size_t trimmed_max = 0;
+    if(m_options.autoskip) {
+	for(auto &elapsed: elapsed_time_array) {
+	    if(!std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
+		continue;
+	    }
+	    std::vector<double> series;
+	    for(auto &it: elapsed.first.latency) {
+		series.push_back(it.count());
+	    }
+	    auto count = mser5(series);
+	    cold.insert(cold.end(), series.begin(), series.begin() + count);
+	    trimmed_max = std::max(trimmed_max, count);
+	    trim(elapsed.first, count);
+	}
+    }
+
+    std::vector<std::tuple<std::string, std::string, std::string>> fact_rows {
+	{ "algorithm", "algorithm", name },
+	{ "vector size", "vector.size", i2s(m_vectors.at(testcase).size()) },
+	{ "vector unit", "vector.unit", "Byte" },
+	{ "key label", "label", label },
+	{ "number of threads", "threads", i2s(numthreads / m_options.queuedepth) }
+    };
+
+    if(m_options.queuedepth > 1) {
+	fact_rows.emplace_back( "queue depth (operations in flight/thread)", "queue.depth", i2s(m_options.queuedepth) );
+    }
+
+    if(m_options.processes) {
+	fact_rows.emplace_back( "number of processes", "processes", i2s(m_options.processes->size()) );
+    }
 
-	// timer_res is the resolution of the timer
-	Measure<> timer_res(m_timer_res.count(), m_timer_res_err.count(), "ns");
-	result_rows.emplace_back(std::forward_as_tuple("timer resolution", "timer resolution", std::move(timer_res)));
+    if(m_options.autoskip) {
+	fact_rows.emplace_back( "warm-up detection", "warmup.rule", "MSER-5, per thread" );
+    }
 
-	// epsilon represents the max resolution we have for a latency measurement.
-	// It sums the resolution and its standard error to it,
-	// ( = 2x stddev on sample mean, to reach 95% of interval)
-	// it is multiplied by two, as an interval is measured by making two time measurements. Therefore the
-	// uncertainties adds up.
-	// It is converted to milliseconds.
+    if(m_options.resamples) {
+	fact_rows.emplace_back( "bootstrap resamples", "bootstrap.resamples", i2s(m_options.resamples) );
+    }
+
+    if(m_options.breakdown) {
+	fact_rows.emplace_back( "phase breakdown", "breakdown", "init, operation, cleanup" );
+    }
+
+    if(m_options.histogram) {
+	fact_rows.emplace_back( "latency recording", "latency.recording", "histogram, " + i2s(*m_options.histogram) + " significant digits" );
+    }
+
+    if(m_options.baseline && *m_options.baseline != name + " using " + label && m_baselines.count(numthreads / m_options.queuedepth)) {
+	fact_rows.emplace_back( "null-operation baseline", "baseline", *m_options.baseline );
+    }
+
+    // the cost of a timer read is taken off each latency; the drift of the timer is measured since it was selected
+    fact_rows.emplace_back( "timer", "timer.source", Timer::name() );
+    fact_rows.emplace_back( "timer read overhead (ns, taken off latencies)", "timer.overhead", d2s(Timer::overhead().count()) );
+    if(Timer::source() == Timer::Source::tsc) {
+	fact_rows.emplace_back( "timer frequency (MHz)", "timer.frequency", d2s(Timer::frequency() / 1e6) );
+    }
+    if(Timer::source() != Timer::Source::steady) {
+	fact_rows.emplace_back( "timer drift against steady clock (ppm)", "timer.drift", d2s(Timer::drift()) );
+    }
+
+    if(m_options.window) {
+	fact_rows.emplace_back( "warm-up duration (s)", "warmup", d2s(std::chrono::duration<double>(m_options.window->warmup).count()) );
+	fact_rows.emplace_back( "measurement duration (s)", "duration", d2s(std::chrono::duration<double>(m_options.window->duration).count()) );
+    } else {
+	// adaptive runs last for several batches of iterations
+	auto iterations = measurement.batches ? measurement.batches * iter : iter;
+	fact_rows.emplace_back( "iterations/thread", "iterations", i2s(iterations) );
+	fact_rows.emplace_back( "skipped iterarions/thread", "iterations", i2s(skipiter) );
+	fact_rows.emplace_back( "total of iterations", "total iterations", i2s(iterations*numthreads) ); // all lanes run the iterations
+    }
+
+    if(m_options.target) {
 	auto epsilon = 2 * std::chrono::duration_cast<milliseconds_double_t>(m_timer_res + m_timer_res_err).count();
+	auto [relerr, p99relerr] = relative_errors(measurement, epsilon);
+	bool reached = relerr <= m_options.target->relerr && (!m_options.target->p99 || p99relerr <= m_options.target->relerr);
+
+	fact_rows.emplace_back( "target relative error", "target.relerr", d2s(m_options.target->relerr) );
+	fact_rows.emplace_back( "target applies to p99", "target.p99", m_options.target->p99 ? "yes" : "no" );
+	fact_rows.emplace_back( "batches of iterations", "target.batches", i2s(measurement.batches) );
+	fact_rows.emplace_back( "target reached", "target.reached", reached ? "yes" : "no" );
+    }
+
+    // when threads are spread across several slots, results are also given per slot
+    std::map<int, std::vector<size_t> > slotthreads;
+    for(size_t th=0; !m_options.threadslots.empty() && th<static_cast<size_t>(numthreads); th++) {
+	slotthreads[m_options.threadslots[measurement.threads[th]]].push_back(th);
+    }
+    const bool multislot = slotthreads.size() > 1;
+
+    if(multislot) {
+	std::string placement;
+	for(size_t th=0; th<static_cast<size_t>(numthreads); th++) {
+	    placement += (th ? "," : "") + i2s(m_options.threadslots[measurement.threads[th]]);
+	}
+	fact_rows.emplace_back( "slot of each thread", "slots", placement );
+    }
+
+    for(size_t op=0; op<measurement.operations.size(); op++) {
+	fact_rows.emplace_back( "operation #" + i2s(op), "operation." + i2s(op) + ".name", measurement.operations[op] );
+    }
+
+    fact_rows.emplace_back( "sessions", "sessions", m_options.sharedsessions ? i2s(m_options.sharedsessions) + " per slot, shared" : "1 per thread" );
+
+    fact_rows.emplace_back( "CPU affinity", "affinity.policy", m_options.affinity.name() );
+    fact_rows.emplace_back( "CPU placement", "affinity.placement", m_options.affinity.placement(measurement.threads) );
+
+    fact_rows.emplace_back( "load model", "load.model", open_loop() ? "open-loop" : "closed-loop" );
+
+    if(m_options.rate > 0) {
+	fact_rows.emplace_back( "arrival rate (Tnx/s)", "load.rate", d2s(m_options.rate) );
+    }
+
+    if(m_options.profile) {
+	fact_rows.emplace_back( "load profile", "load.profile", m_options.profile->name() );
+	for(size_t ph=0; ph<m_options.profile->phases().size(); ph++) {
+	    fact_rows.emplace_back( "phase #" + i2s(ph), "phase." + i2s(ph) + ".load", m_options.profile->describe(ph) );
+	}
+    }
+
+    std::vector<std::tuple<std::string, std::string, Measure<>>> result_rows;
+
+    ConsoleTable facts { "property", "value" };
+    facts.setStyle(1);
+
+    for(auto &row: fact_rows) {
+	facts += { std::get<0>(row), std::get<2>(row) };
+    }
 
-	// if the statistical error is less than epsilon, then it is no more significant,
-	// as the measure is blurred by the resolution of the timer.
-	// In which case, the error on latency is topped to epsilon
-	auto latency_avg_val = stats["mean"]();
-	auto latency_avg_err = stats["error"]() < epsilon ? epsilon : stats["error"]();
-	Measure<> latency_avg(latency_avg_val, latency_avg_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, average", "latency.average", std::move(latency_avg)));
-
-	// let's also add the standard deviation
-	auto latency_stddev_val = stats["sstddev"]();
-	auto latency_stddev_err = stats["error"]() < epsilon ? epsilon : stats["error"]();
-	Measure<> latency_stddev(latency_stddev_val, latency_stddev_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, standard deviation", "latency.stddev", std::move(latency_stddev)));
-
-	// minimum and maximum are measured directly. their error depends directly upon
-	// the measurement of two times, i.e. t2-t1. Therefore, the error on that measurment
-	// equals twice the precision.
-	auto latency_min_val = stats["min"]();
-	auto latency_min_err = epsilon;
-	Measure<> latency_min(latency_min_val, latency_min_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, minimum", "latency.minimum", std::move(latency_min)));
-	auto latency_max_val = stats["max"]();;
-	auto latency_max_err =  epsilon;
-	Measure<> latency_max(latency_max_val, latency_max_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, maximum", "latency.maximum", std::move(latency_max)));
-
-	// p95, p98, p99 quantiles
-	auto latency_p95_val = stats["p95"]();
-	auto latency_p95_err = epsilon;
-	Measure<> latency_p95(latency_p95_val, latency_p95_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, 95th percentile", "latency.p95", std::move(latency_p95)));
-	auto latency_p98_val = stats["p98"]();
-	auto latency_p98_err = epsilon;
-	Measure<> latency_p98(latency_p98_val, latency_p98_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, 98th percentile", "latency.p98", std::move(latency_p98)));
-	auto latency_p99_val = stats["p99"]();
-	auto latency_p99_err = epsilon;
-	Measure<> latency_p99(latency_p99_val, latency_p99_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, 99th percentile", "latency.p99", std::move(latency_p99)));
-
-	// log-normal stats
-	auto latency_log_geomavg_val = stats["logavg"]();
-	auto latency_log_geomavg_err = stats["logerror"]();
-	Measure<> latency_log_geomavg(latency_log_geomavg_val, latency_log_geomavg_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, log-normal geom average", "latency.logavg", std::move(latency_log_geomavg)));
-	auto latency_log_geomsstddev_val = stats["logsstdev"]();
-	auto latency_log_geomsstddev_err = stats["logerror"]();
-	Measure<> latency_log_geomsstddev(latency_log_geomsstddev_val, latency_log_geomsstddev_err, "ms");
-	result_rows.emplace_back(std::forward_as_tuple("latency, log-normal geom stddev", "latency.logstddev", std::move(latency_log_geomsstddev)));
-
-	// Kolmogorov-Smirnov goodness-of-fit tests with Lilliefors correction
-	// (parameters estimated from data, not known a priori)
-	// Critical values at alpha=0.05: ~0.886/√n - 0.01/n (reject if D > Dcrit)
+    std::cout << name + " with key " + label << '\n'
+	      << "================================================================================\n"
+	      << "Test case facts:\n"
+	      << facts << std::endl;
+
+    // the sample size is the number of operations recorded over all threads
+    // (in duration-based mode, it is only known after execution)
+    size_t sample_size = 0;
+    for(auto &elapsed: elapsed_time_array) {
+	sample_size += elapsed.first.latency.size();
+    }
+
+    // response times (open-loop mode), i.e. measured from the intended start,
+    // and time spent waiting for a session (session pool only)
+    std::vector<double> responses, checkouts;
+    size_t missed_slots = 0;
+
+    // latencies of all threads are gathered in a single buffer, over which all statistics are computed
+    std::vector<double> latencies;
+    latencies.reserve(sample_size);
+    std::vector<double> init_latencies, operation_latencies, cleanup_latencies; // phase breakdown only
+    for(auto &elapsed: elapsed_time_array) {
+	if(!std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
+	    last_errcode = elapsed.second;
+	    wallclock_elapsed = milliseconds_double_t { 0 };
+	    break;		// something wrong happened, no need to carry on
+	}
+
+	for(auto &it: elapsed.first.latency) {
+	    latencies.push_back(it.count());
+	}
+
+	for(auto &it: elapsed.first.response) {
+	    responses.push_back(it.count());
+	}
+	missed_slots += elapsed.first.missed;
+
+	for(auto &it: elapsed.first.checkout) {
+	    checkouts.push_back(it.count());
+	}
+
+	// the operation phase is what remains of the latency, once init calls are taken off
+	for(size_t i=0; i<elapsed.first.init.size() && i<elapsed.first.latency.size(); i++) {
+	    init_latencies.push_back(elapsed.first.init[i].count());
+	    operation_latencies.push_back(elapsed.first.latency[i].count() - elapsed.first.init[i].count());
+	}
+	for(auto &it: elapsed.first.cleanup) {
+	    cleanup_latencies.push_back(it.count());
+	}
+    }
+    const SampleStatistics sample { std::move(latencies) };
+
+    // helper map table for statistics
+    std::map<std::string, std::function<double()> > stats {
+	{ "min",   [&sample] () { return sample.min();  }},
+	{ "mean",  [&sample] () { return sample.mean(); }},
+	{ "max",   [&sample] () { return sample.max();  }},
+	{ "range", [&sample] () { return (sample.max() - sample.min()); }},
+	{ "svar",  [&sample] () { return sample.variance(); }},
+	{ "sstddev", [&stats] () { return std::sqrt(stats["svar"]()); }},
+	// note: for error, we take k=2 so 95% of measures are within interval
+	{ "error", [&stats] () { return std::sqrt(stats["svar"]()/static_cast<double>( stats["count"]() ))*2; }},
+	{ "count", [&sample] () { return static_cast<double>(sample.count()); }},
+	// log1p() is used for small values, i.e. exp(x)-1 gets back to the latency
+	{ "logavg", [&sample] () {
+	    return sample.uses_log1p() ? std::expm1( sample.logmean() ) : std::exp( sample.logmean() );
+	}},
+	{ "logsvar", [&sample] () {
+	    return sample.uses_log1p() ? std::expm1( sample.logvariance() ) : std::exp( sample.logvariance() );
+	}},
+	{ "logsstdev", [&stats] () { return std::sqrt(stats["logsvar"]()); }},
+	{ "logerror", [&stats] () { return std::sqrt(stats["logsvar"]()/static_cast<double>( stats["count"]() ))*2; }},
+	// Kolmogorov-Smirnov goodness-of-fit tests
+	{ "ks_normal", [&sample] () { return sample.ks_normal(); }},
+	{ "ks_lognormal", [&sample] () { return sample.ks_lognormal(); }}
+    };
+
+    // histogram mode: latencies were counted per thread, and the statistics are drawn from the merged histograms.
+    // Mean, variance, minimum and maximum are exact; percentiles are within the precision of the histogram,
+    // and the log-normal statistics are computed from the middle of each bucket.
+    std::optional<Histogram> histogram;
+    if(m_options.histogram) {
+	histogram.emplace(*m_options.histogram);
+	for(auto &elapsed: elapsed_time_array) {
+	    if(!std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
+		break;
+	    }
+	    if(elapsed.first.histogram) {
+		histogram->merge(*elapsed.first.histogram);
+	    }
+	}
+
+	const bool use_log1p = histogram->count() > 0 && histogram->mean() < 1.0;
+	double logsum = 0.0, logsumsq = 0.0;
+	for(auto &[value, count]: histogram->buckets()) {
+	    double logval = use_log1p ? std::log1p(value) : std::log(value);
+	    logsum += count * logval;
+	    logsumsq += count * logval * logval;
+	}
+	const double n = histogram->count();
+	const double logmean = n > 0 ? logsum / n : 0.0;
+	const double logsvar = n > 1 ? std::max(0.0, (logsumsq - n * logmean * logmean) / (n - 1)) : 0.0;
+
+	stats["min"] = [&histogram] () { return histogram->min(); };
+	stats["mean"] = [&histogram] () { return histogram->mean(); };
+	stats["max"] = [&histogram] () { return histogram->max(); };
+	stats["range"] = [&histogram] () { return histogram->max() - histogram->min(); };
+	stats["svar"] = [&histogram] () { return histogram->variance(); };
+	stats["count"] = [&histogram] () { return static_cast<double>(histogram->count()); };
+	stats["logavg"] = [=] () { return use_log1p ? std::expm1(logmean) : std::exp(logmean); };
+	stats["logsvar"] = [=] () { return use_log1p ? std::expm1(logsvar) : std::exp(logsvar); };
+    }
+
+    auto vector_size = m_vectors.at(testcase).size();
+    auto stats_count = stats["count"]();
+
+    // timer_res is the resolution of the timer
+    Measure<> timer_res(m_timer_res.count(), m_timer_res_err.count(), "ns");
+    result_rows.emplace_back(std::forward_as_tuple("timer resolution", "timer resolution", std::move(timer_res)));
+
+    // epsilon represents the max resolution we have for a latency measurement.
+    // It sums the resolution and its standard error to it,
+    // ( = 2x stddev on sample mean, to reach 95% of interval)
+    // it is multiplied by two, as an interval is measured by making two time measurements. Therefore the
+    // uncertainties adds up.
+    // It is converted to milliseconds.
+    auto epsilon = 2 * std::chrono::duration_cast<milliseconds_double_t>(m_timer_res + m_timer_res_err).count();
+
+    // if the statistical error is less than epsilon, then it is no more significant,
+    // as the measure is blurred by the resolution of the timer.
+    // In which case, the error on latency is topped to epsilon
+    auto latency_avg_val = stats["mean"]();
+    auto latency_avg_err = stats["error"]() < epsilon ? epsilon : stats["error"]();
+    Measure<> latency_avg(latency_avg_val, latency_avg_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, average", "latency.average", std::move(latency_avg)));
+
+    // null-operation baseline: its average latency is the cost of a round trip through the library (and to the server,
+    // for network HSMs). It is recorded when the baseline runs, then taken off the average latency of the test cases
+    // run afterwards with the same number of threads. Errors add up.
+    const int clients = numthreads / m_options.queuedepth;
+    if(m_options.baseline && std::holds_alternative<benchmark_result::Ok>(last_errcode) && stats_count > 0) {
+	auto baseline = m_baselines.find(clients);
+	if(*m_options.baseline == name + " using " + label) {
+	    if(baseline == m_baselines.end()) { // the baseline runs with the first test vector only
+		m_baselines.emplace(clients, std::make_pair(latency_avg_val, latency_avg_err));
+	    }
+	} else if(baseline != m_baselines.end()) {
+	    auto [baseline_val, baseline_err] = baseline->second;
+	    Measure<> latency_net(latency_avg_val - baseline_val, latency_avg_err + baseline_err, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple("latency, average, net of baseline", "latency.net.average", std::move(latency_net)));
+	    auto share = baseline_val / latency_avg_val;
+	    Measure<> baseline_share(100 * share, 100 * share * (baseline_err / baseline_val + latency_avg_err / latency_avg_val), "%");
+	    result_rows.emplace_back(std::forward_as_tuple("baseline share of latency", "latency.baseline.share", std::move(baseline_share)));
+	}
+    }
+
+    // let's also add the standard deviation
+    auto latency_stddev_val = stats["sstddev"]();
+    auto latency_stddev_err = stats["error"]() < epsilon ? epsilon : stats["error"]();
+    Measure<> latency_stddev(latency_stddev_val, latency_stddev_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, standard deviation", "latency.stddev", std::move(latency_stddev)));
+
+    // minimum and maximum are measured directly. their error depends directly upon
+    // the measurement of two times, i.e. t2-t1. Therefore, the error on that measurment
+    // equals twice the precision.
+    auto latency_min_val = stats["min"]();
+    auto latency_min_err = epsilon;
+    Measure<> latency_min(latency_min_val, latency_min_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, minimum", "latency.minimum", std::move(latency_min)));
+    auto latency_max_val = stats["max"]();;
+    auto latency_max_err =  epsilon;
+    Measure<> latency_max(latency_max_val, latency_max_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, maximum", "latency.maximum", std::move(latency_max)));
+
+    // percentiles: exact order statistics over the sorted latencies, or read from the merged histogram in histogram mode.
+    // Each comes with a distribution-free 95% confidence interval, between the order statistics of ranks n.p -/+ 1.96.sqrt(n.p.(1-p)).
+    // When the sample is too small for these ranks to exist, the extreme values are taken instead: the interval is then
+    // incomplete, i.e. it covers less than 95%. The error is the largest distance from the percentile to a bound.
+    // order_statistic(): latency of a rank, from 1
+    auto order_statistic = [&] (size_t rank) {
+	return histogram ? histogram->at(rank) : sample.at(rank);
+    };
+
+    // with bootstrap resamples, percentiles and global TPS are also given a bootstrap interval, which then sets their error
+    const Bootstrap bootstrap { m_options.resamples };
+    std::vector<std::tuple<std::string, double, double> > bootstrap_cis; // key, lower and upper bounds
+
+    std::vector<std::tuple<std::string, double, double, bool> > percentile_cis; // key, lower and upper bounds, complete
+
+    // percentile_rows(): rows of the percentiles of count values, the value of rank r being at(r);
+    // precision is the relative precision of these values (histogram mode), 0 when they are exact.
+    // Corrected latency and session checkout wait are given the same percentiles as the latency.
+    auto percentile_rows = [&] (const std::string &label, const std::string &prefix, size_t count,
+				const std::function<double(size_t)> &at, double precision) {
+	for(auto pct: m_options.percentiles) {
+	    const double n = static_cast<double>(count), p = pct / 100;
+	    double value = 0.0, lower = 0.0, upper = 0.0;
+	    bool complete = false;
+	    if(n > 0) {
+		auto spread = 1.96 * std::sqrt(n * p * (1 - p));
+		auto lo = std::floor(n * p - spread), hi = std::ceil(n * p + spread);
+		complete = lo >= 1 && hi <= n;
+		value = at(static_cast<size_t>(std::clamp(std::ceil(n * p), 1.0, n)));
+		lower = at(static_cast<size_t>(std::clamp(lo, 1.0, n)));
+		upper = at(static_cast<size_t>(std::clamp(hi, 1.0, n)));
+	    }
+
+	    auto [name, key] = percentile_name(pct);
+	    percentile_cis.emplace_back(prefix + ".p" + key, lower, upper, complete);
+
+	    if(m_options.resamples && n > 0) {
+		auto interval = bootstrap.rank(static_cast<size_t>(n), static_cast<size_t>(std::clamp(std::ceil(n * p), 1.0, n)), at);
+		lower = interval.lower;
+		upper = interval.upper;
+		bootstrap_cis.emplace_back(prefix + ".p" + key, lower, upper);
+	    }
+
+	    auto error = std::max({ value - lower, upper - value, epsilon });
+	    error = std::max(error, value * precision);
+	    Measure<> latency_percentile(value, error, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(label + ", " + name + " percentile", prefix + ".p" + key, std::move(latency_percentile)));
+	}
+    };
+    percentile_rows("latency", "latency", static_cast<size_t>(stats_count), order_statistic,
+		    histogram ? std::pow(10.0, -*m_options.histogram) : 0.0); // precision of the histogram
+
+    // open-loop mode: response times are measured from the intended start of each operation,
+    // and therefore include the time spent waiting for the previous operation to complete
+    // (coordinated omission correction).
+    if(open_loop() && !responses.empty()) {
+	const SampleStatistics corrected { std::move(responses) };
+	auto n = static_cast<double>(corrected.count());
+	// a single response gives no variance: the error then falls back to epsilon
+	auto response_err = n > 1 ? std::sqrt(corrected.variance() / n) * 2 : epsilon;
+	if(response_err < epsilon) response_err = epsilon;
+
+	Measure<> response_avg(corrected.mean(), response_err, "ms");
+	result_rows.emplace_back(std::forward_as_tuple("latency (corrected), average", "latency.corrected.average", std::move(response_avg)));
+	Measure<> response_max(corrected.max(), epsilon, "ms");
+	result_rows.emplace_back(std::forward_as_tuple("latency (corrected), maximum", "latency.corrected.maximum", std::move(response_max)));
+	percentile_rows("latency (corrected)", "latency.corrected", corrected.count(),
+			[&corrected] (size_t rank) { return corrected.at(rank); }, 0.0);
+	Measure<> missed(static_cast<double>(missed_slots), "slots");
+	result_rows.emplace_back(std::forward_as_tuple("missed slots", "schedule.missed", std::move(missed)));
+    }
+
+    // session pool: the wait for a free session is measured apart from the latency.
+    // Its share of the time spent per operation tells whether the pool is too small.
+    if(m_options.sharedsessions && checkouts.size() > 1) {
+	const SampleStatistics checkout { std::move(checkouts) };
+	auto n = static_cast<double>(checkout.count());
+	auto checkout_err = std::sqrt(checkout.variance() / n) * 2;
+	if(checkout_err < epsilon) checkout_err = epsilon;
+
+	Measure<> checkout_avg(checkout.mean(), checkout_err, "ms");
+	result_rows.emplace_back(std::forward_as_tuple("session checkout wait, average", "checkout.average", std::move(checkout_avg)));
+	Measure<> checkout_max(checkout.max(), epsilon, "ms");
+	result_rows.emplace_back(std::forward_as_tuple("session checkout wait, maximum", "checkout.maximum", std::move(checkout_max)));
+	percentile_rows("session checkout wait", "checkout", checkout.count(),
+			[&checkout] (size_t rank) { return checkout.at(rank); }, 0.0);
+	Measure<> checkout_share(100 * checkout.mean() / (checkout.mean() + latency_avg_val), "%");
+	result_rows.emplace_back(std::forward_as_tuple("session checkout wait, share of operation time", "checkout.share", std::move(checkout_share)));
+    }
+
+    // phase breakdown: the latency is split between init calls (e.g. C_EncryptInit) and the operation itself;
+    // cleanup (e.g. C_DestroyObject) follows, and is not part of the latency. Each phase has its own distribution.
+    // Test cases without a separate init call (e.g. signatures through Botan) spend all their latency in the operation phase,
+    // and get no init phase.
+    if(m_options.breakdown && stats_count > 0) {
+	const std::vector<std::tuple<std::string, std::string, std::vector<double> *> > phases {
+	    { "init phase", "latency.init", &init_latencies },
+	    { "operation phase", "latency.operation", &operation_latencies },
+	    { "cleanup phase", "latency.cleanup", &cleanup_latencies }
+	};
+	for(auto &[phaselabel, phasekey, values]: phases) {
+	    const SampleStatistics phase { std::move(*values) };
+	    if(phase.empty() || phase.max() == 0.0) { // e.g. no init call
+		continue;
+	    }
+	    auto n = static_cast<double>(phase.count());
+	    auto phase_err = n > 1 ? std::sqrt(phase.variance() / n) * 2 : 0.0;
+	    Measure<> phase_avg(phase.mean(), std::max(phase_err, epsilon), "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", average", phasekey + ".average", std::move(phase_avg)));
+	    if(phasekey != "latency.cleanup") {
+		Measure<> phase_share(100 * phase.mean() / latency_avg_val, "%");
+		result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", share of latency", phasekey + ".share", std::move(phase_share)));
+	    }
+	    Measure<> phase_max(phase.max(), epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", maximum", phasekey + ".maximum", std::move(phase_max)));
+	    percentile_rows(phaselabel, phasekey, phase.count(), [&phase] (size_t rank) { return phase.at(rank); }, 0.0);
+	}
+    }
+
+    // automatic warm-up detection: how much was trimmed, and how slower the transient was
+    if(m_options.autoskip && stats_count > 0) {
+	Measure<> trimmed(static_cast<double>(cold.size()), "Tnx");
+	result_rows.emplace_back(std::forward_as_tuple("warm-up, operations trimmed", "warmup.trimmed", std::move(trimmed)));
+	Measure<> trimmed_thread(static_cast<double>(trimmed_max), "Tnx");
+	result_rows.emplace_back(std::forward_as_tuple("warm-up, operations trimmed/thread, maximum", "warmup.trimmed.max", std::move(trimmed_thread)));
+
+	if(!cold.empty()) {
+	    double sum = 0.0;
+	    for(auto val: cold) {
+		sum += val;
+	    }
+	    auto cold_avg_val = sum / cold.size();
+	    Measure<> cold_avg(cold_avg_val, epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple("warm-up, latency, average", "warmup.latency.average", std::move(cold_avg)));
+	    Measure<> cold_delta(cold_avg_val - latency_avg_val, latency_avg_err + epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple("warm-up, latency delta (cold - warm)", "warmup.latency.delta", std::move(cold_delta)));
+	}
+    }
+
+    // log-normal stats
+    auto latency_log_geomavg_val = stats["logavg"]();
+    auto latency_log_geomavg_err = stats["logerror"]();
+    Measure<> latency_log_geomavg(latency_log_geomavg_val, latency_log_geomavg_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, log-normal geom average", "latency.logavg", std::move(latency_log_geomavg)));
+    auto latency_log_geomsstddev_val = stats["logsstdev"]();
+    auto latency_log_geomsstddev_err = stats["logerror"]();
+    Measure<> latency_log_geomsstddev(latency_log_geomsstddev_val, latency_log_geomsstddev_err, "ms");
+    result_rows.emplace_back(std::forward_as_tuple("latency, log-normal geom stddev", "latency.logstddev", std::move(latency_log_geomsstddev)));
+
+    // Kolmogorov-Smirnov goodness-of-fit tests with Lilliefors correction
+    // (parameters estimated from data, not known a priori)
+    // Critical values at alpha=0.05: ~0.886/√n - 0.01/n (reject if D > Dcrit)
+    // They need the individual latencies, and are not available in histogram mode.
+    if(!histogram) {
 	auto dcrit = [] (size_t n) -> double {
 	    return 0.886 / std::sqrt(static_cast<double>(n)) - 0.01 / static_cast<double>(n);
 	};
@@ -430,84 +1067,791 @@ ptree Executor::benchmark( P11Benchmark &benchmark, const size_t iter, const siz
 	ks_fit_str = (ks_lognormal_val > ks_lognormal_dcrit) ? "rejected" : "not rejected";
 	Measure<> ks_lognormal_fit(ks_lognormal_val - ks_lognormal_dcrit, 0, ks_fit_str);
 	result_rows.emplace_back(std::forward_as_tuple("Lilliefors test, fitness (lognormal)", "ks.lognormal.fit", std::move(ks_lognormal_fit)));
+    }
+
+    // TPS is the number of "transactions" per second.
+    // the meaning of "transaction" depends upon the tested API/algorithm
+
+    // the statistics are computed over all threads. Therefore, the TPS it yields is per thread.
+    auto tps_thread_avg_val = 1000 / stats["mean"]();
+    auto tps_thread_avg_err = 1000 * latency_avg_err / (latency_avg_val*latency_avg_val) ;
+    Measure<> tps_thread_avg(tps_thread_avg_val, tps_thread_avg_err, "Tnx/s");
+    result_rows.emplace_back(std::forward_as_tuple("TPS/thread, average", "tps.thread", std::move(tps_thread_avg)));
+    // global TPS is simply obtained by multiplying TPS/thread by the number of threads
+    auto tps_global_avg_val = tps_thread_avg_val * numthreads;
+    auto tps_global_avg_err = tps_thread_avg_err * numthreads;
+    // its bootstrap interval follows from that of the average latency (the TPS decreases as the latency grows).
+    // In histogram mode, latencies cannot be resampled, and the error above remains.
+    if(m_options.resamples && !histogram && sample.count() > 1) {
+	auto interval = bootstrap.mean(sample.sorted());
+	auto lower = 1000 * numthreads / interval.upper, upper = 1000 * numthreads / interval.lower;
+	tps_global_avg_err = std::max(tps_global_avg_val - lower, upper - tps_global_avg_val);
+	bootstrap_cis.emplace_back("tps.global", lower, upper);
+    }
+    Measure<> tps_global_avg(tps_global_avg_val, tps_global_avg_err, "Tnx/s");
+    result_rows.emplace_back(std::forward_as_tuple("global TPS, average", "tps.global", std::move(tps_global_avg)));
+    // with several operations in flight per thread, the TPS above is per lane; the TPS of a thread sums its lanes
+    if(m_options.queuedepth > 1) {
+	Measure<> tps_client_avg(tps_thread_avg_val * m_options.queuedepth, tps_thread_avg_err * m_options.queuedepth, "Tnx/s");
+	result_rows.emplace_back(std::forward_as_tuple("TPS/thread (all lanes), average", "tps.client", std::move(tps_client_avg)));
+    }
+    // throughput is obtained by multiplying TPS by vector size.
+    // Note that it is probably meaningful only to bulk encryption algorithms.
+    auto throughput_thread_avg_val = 1000 * vector_size / stats["mean"]();
+    auto throughput_thread_avg_err = 1000 * vector_size * latency_avg_err / (latency_avg_val*latency_avg_val);
+    Measure<> throughput_thread_avg(throughput_thread_avg_val, throughput_thread_avg_err, "Byte/s");
+    result_rows.emplace_back(std::forward_as_tuple("throughput/thread, average", "throughput.thread", std::move(throughput_thread_avg)));
+
+    auto throughput_global_avg_val = throughput_thread_avg_val * numthreads;
+    auto throughput_global_avg_err = throughput_thread_avg_err * numthreads;
+    Measure<> throughput_global_avg(throughput_global_avg_val, throughput_global_avg_err, "Byte/s");
+    result_rows.emplace_back(std::forward_as_tuple("global throughput, average", "throughput.global", std::move(throughput_global_avg)));
+
+    // in duration-based mode, we can also compute TPS from the operations actually completed
+    // during the measurement window. Unlike the figure above, it does not assume that threads
+    // were continuously busy.
+    if(m_options.window) {
+	Measure<> recorded_ops(stats_count, "Tnx");
+	result_rows.emplace_back(std::forward_as_tuple("operations, completed in window", "operations", std::move(recorded_ops)));
+
+	auto window_s = std::chrono::duration<double>(m_options.window->duration).count();
+	Measure<> tps_global_measured(stats_count / window_s, "Tnx/s");
+	result_rows.emplace_back(std::forward_as_tuple("global TPS, measured", "tps.measured", std::move(tps_global_measured)));
+    }
+
+    // steady state: the global TPS above assumes that all threads overlap for the whole run. In practice, threads
+    // start and finish at different times, and concurrency drops at both ends. The steady-state window spans from
+    // the latest first operation to the earliest last operation, among all threads: every thread is busy all along,
+    // and the TPS measured from the operations started in that window can be compared with the derived one.
+    // (batches of adaptive runs are separated by idle periods, so there is no such window)
+    if(std::holds_alternative<benchmark_result::Ok>(last_errcode) && measurement.batches <= 1 && stats_count > 0) {
+	double window_start = 0.0, window_end = std::numeric_limits<double>::max();
+	for(auto &elapsed: elapsed_time_array) {
+	    auto &timestamps = elapsed.first.timestamp;
+	    if(timestamps.empty()) {
+		window_end = 0.0; // a thread did not record anything
+		break;
+	    }
+	    window_start = std::max(window_start, timestamps[0].count());
+	    window_end = std::min(window_end, timestamps[timestamps.size()-1].count());
+	}
+
+	size_t steady_ops = 0;
+	for(auto &elapsed: elapsed_time_array) {
+	    for(auto &it: elapsed.first.timestamp) {
+		if(it.count() >= window_start && it.count() < window_end) {
+		    steady_ops++;
+		}
+	    }
+	}
+
+	if(window_end > window_start && steady_ops > 1) {
+	    auto tps_steady_val = 1000 * steady_ops / (window_end - window_start);
+	    auto tps_derived_val = m_options.window ? stats_count / std::chrono::duration<double>(m_options.window->duration).count() : tps_global_avg_val;
+
+	    Measure<> steady_duration(window_end - window_start, epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple("steady-state window, duration", "steady.duration", std::move(steady_duration)));
+	    Measure<> steady_share(100 * (window_end - window_start) / wallclock_elapsed.count(), "%");
+	    result_rows.emplace_back(std::forward_as_tuple("steady-state window, share of wall clock", "steady.share", std::move(steady_share)));
+	    Measure<> steady_operations(static_cast<double>(steady_ops), "Tnx");
+	    result_rows.emplace_back(std::forward_as_tuple("steady-state window, operations", "steady.operations", std::move(steady_operations)));
+	    Measure<> tps_steady(tps_steady_val, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple("global TPS, steady state", "tps.steady", std::move(tps_steady)));
+	    Measure<> tps_discrepancy(100 * (tps_derived_val / tps_steady_val - 1), "%");
+	    result_rows.emplace_back(std::forward_as_tuple("global TPS, discrepancy vs steady state", "tps.discrepancy", std::move(tps_discrepancy)));
+	}
+    }
+
+    // per slot statistics: latency and TPS of the threads bound to each slot,
+    // and the imbalance between slots, as the ratio between the best and the worst TPS per thread
+    if(multislot && std::holds_alternative<benchmark_result::Ok>(last_errcode)) {
+	double best = 0.0, worst = std::numeric_limits<double>::max();
 
-	// TPS is the number of "transactions" per second.
-	// the meaning of "transaction" depends upon the tested API/algorithm
-
-	// the statistics are computed over all threads. Therefore, the TPS it yields is per thread.
-	auto tps_thread_avg_val = 1000 / stats["mean"]();
-	auto tps_thread_avg_err = 1000 * latency_avg_err / (latency_avg_val*latency_avg_val) ;
-	Measure<> tps_thread_avg(tps_thread_avg_val, tps_thread_avg_err, "Tnx/s");
-	result_rows.emplace_back(std::forward_as_tuple("TPS/thread, average", "tps.thread", std::move(tps_thread_avg)));
-	// global TPS is simply obtained by multiplying TPS/thread by the number of threads
-	auto tps_global_avg_val = tps_thread_avg_val * m_numthreads;
-	auto tps_global_avg_err = tps_thread_avg_err * m_numthreads;
-	Measure<> tps_global_avg(tps_global_avg_val, tps_global_avg_err, "Tnx/s");
-	result_rows.emplace_back(std::forward_as_tuple("global TPS, average", "tps.global", std::move(tps_global_avg)));
-	// throughput is obtained by multiplying TPS by vector size.
-	// Note that it is probably meaningful only to bulk encryption algorithms.
-	auto throughput_thread_avg_val = 1000 * vector_size / stats["mean"]();
-	auto throughput_thread_avg_err = 1000 * vector_size * latency_avg_err / (latency_avg_val*latency_avg_val);
-	Measure<> throughput_thread_avg(throughput_thread_avg_val, throughput_thread_avg_err, "Byte/s");
-	result_rows.emplace_back(std::forward_as_tuple("throughput/thread, average", "throughput.thread", std::move(throughput_thread_avg)));
-
-	auto throughput_global_avg_val = throughput_thread_avg_val * m_numthreads;
-	auto throughput_global_avg_err = throughput_thread_avg_err * m_numthreads;
-	Measure<> throughput_global_avg(throughput_global_avg_val, throughput_global_avg_err, "Byte/s");
-	result_rows.emplace_back(std::forward_as_tuple("global throughput, average", "throughput.global", std::move(throughput_global_avg)));
-
-	// wallclock_elapsed_ms is the total time elapsed (in ms).
-	Measure<> wallclock_elapsed_ms( wallclock_elapsed.count(), epsilon, "ms" );
-	result_rows.emplace_back(std::forward_as_tuple("wall clock", "wallclock", std::move(wallclock_elapsed_ms)));
-
-	ConsoleTable results{"measure", "value", "error (+/-)", "unit", "rel. error" };
-	results.setStyle(1);
-
-	for(auto &row: result_rows) {
-	    results += {
-		std::get<0>(row),
-		    d2s(std::get<2>(row).value(),12),
-		    d2s(std::get<2>(row).error(),12),
-		    std::get<2>(row).unit(),
-		    d2s(std::get<2>(row).relerr()*100,3)+'%'  };
-	}
-
-	std::cout << "Test case results:\n" << results << std::endl;
-
-	// now create json output
-	std::string thistestcase { benchmark.label() + '.' + testcase + '.' };
-
-	// adding facts information
-	for(auto &row: fact_rows) {
-	    rv.add(thistestcase + std::get<1>(row), std::get<2>(row) );
-	}
-
-	// adding results information
-	for(auto &row: result_rows) {
-	    rv.add<double>(thistestcase + std::get<1>(row) + ".value",  std::get<2>(row).value());
-	    rv.add(thistestcase + std::get<1>(row) + ".unit",   std::get<2>(row).unit());
-	    rv.add(thistestcase + std::get<1>(row) + ".error",  d2s(std::get<2>(row).error()));
-	    rv.add(thistestcase + std::get<1>(row) + ".relerr", d2s(std::get<2>(row).relerr()));
-	}
-
-	// adding measured datapoints if requested
-	if(m_include_datapoints) {
-	    ptree datapoints_array;
-	    for(auto elapsed: elapsed_time_array) {
-		if(std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
-		    for(auto &it: elapsed.first) {
-			ptree datapoint;
-			datapoint.put("", it.count());
-			datapoints_array.push_back(std::make_pair("", datapoint));
+	for(auto &[slotindex, slotths]: slotthreads) {
+	    std::vector<double> slotlatencies;
+	    std::optional<Histogram> slot_histogram;
+	    if(histogram) {
+		slot_histogram.emplace(*m_options.histogram);
+	    }
+	    for(auto th: slotths) {
+		for(auto &it: elapsed_time_array[th].first.latency) {
+		    slotlatencies.push_back(it.count());
+		}
+		if(slot_histogram && elapsed_time_array[th].first.histogram) {
+		    slot_histogram->merge(*elapsed_time_array[th].first.histogram);
+		}
+	    }
+
+	    const SampleStatistics slot { std::move(slotlatencies) };
+	    auto n = slot_histogram ? slot_histogram->count() : slot.count();
+	    if(n < 2) {
+		continue;	// not enough measures on that slot
+	    }
+
+	    std::string slotlabel { "slot " + i2s(slotindex) };
+	    std::string slotkey { "slot." + i2s(slotindex) };
+	    auto slot_avg_val = slot_histogram ? slot_histogram->mean() : slot.mean();
+	    auto slot_avg_err = std::sqrt( (slot_histogram ? slot_histogram->variance() : slot.variance()) / n ) * 2;
+	    if(slot_avg_err < epsilon) slot_avg_err = epsilon;
+	    auto slot_tps = m_options.window ?
+		n / std::chrono::duration<double>(m_options.window->duration).count() :
+		1000 * slotths.size() / slot_avg_val;
+
+	    Measure<> slot_threads(static_cast<double>(slotths.size()), "threads");
+	    result_rows.emplace_back(std::forward_as_tuple(slotlabel + ", threads", slotkey + ".threads", std::move(slot_threads)));
+	    Measure<> slot_avg(slot_avg_val, slot_avg_err, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(slotlabel + ", latency, average", slotkey + ".latency.average", std::move(slot_avg)));
+	    Measure<> slot_tps_measure(slot_tps, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple(slotlabel + ", TPS", slotkey + ".tps", std::move(slot_tps_measure)));
+
+	    best = std::max(best, slot_tps / slotths.size());
+	    worst = std::min(worst, slot_tps / slotths.size());
+	}
+
+	if(best > 0 && worst > 0 && worst < std::numeric_limits<double>::max()) {
+	    Measure<> imbalance(best / worst, "");
+	    result_rows.emplace_back(std::forward_as_tuple("slot imbalance, TPS/thread best/worst", "slot.imbalance", std::move(imbalance)));
+	}
+    }
+
+    // mixed workload: statistics per operation. The TPS of an operation is its share of the global TPS.
+    if(!measurement.operations.empty() && std::holds_alternative<benchmark_result::Ok>(last_errcode) && stats_count > 0) {
+	std::vector<std::vector<double> > oplatencies(measurement.operations.size());
+	for(auto &elapsed: elapsed_time_array) {
+	    size_t i = 0;
+	    for(auto &it: elapsed.first.latency) {
+		oplatencies.at(elapsed.first.operation[i++]).push_back(it.count());
+	    }
+	}
+
+	auto global_tps = m_options.window ? stats_count / std::chrono::duration<double>(m_options.window->duration).count() : tps_global_avg_val;
+
+	for(size_t op=0; op<oplatencies.size(); op++) {
+	    const SampleStatistics latencies { std::move(oplatencies[op]) };
+	    std::string oplabel { "operation #" + i2s(op) };
+	    std::string opkey { "operation." + i2s(op) };
+	    auto n = latencies.count();
+	    auto share = static_cast<double>(n) / stats_count;
+
+	    Measure<> op_share(100 * share, "%");
+	    result_rows.emplace_back(std::forward_as_tuple(oplabel + ", share of operations", opkey + ".share", std::move(op_share)));
+	    if(n < 2) {
+		continue;	// not enough measures for that operation
+	    }
+
+	    auto op_avg_err = std::sqrt( latencies.variance() / n ) * 2;
+	    if(op_avg_err < epsilon) op_avg_err = epsilon;
+
+	    Measure<> op_avg(latencies.mean(), op_avg_err, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(oplabel + ", latency, average", opkey + ".latency.average", std::move(op_avg)));
+	    Measure<> op_p99(latencies.percentile(0.99), epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(oplabel + ", latency, 99th percentile", opkey + ".latency.p99", std::move(op_p99)));
+	    Measure<> op_tps(global_tps * share, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple(oplabel + ", TPS", opkey + ".tps", std::move(op_tps)));
+	}
+    }
+
+    // load profile: statistics per phase, the phase of an operation being the one it started in.
+    // Operations are recorded until the end of the profile, so the TPS of each phase is measured over its duration.
+    if(m_options.profile && std::holds_alternative<benchmark_result::Ok>(last_errcode)) {
+	auto &phases = m_options.profile->phases();
+	std::vector<std::vector<double> > phaselatencies(phases.size()), phaseresponses(phases.size());
+	for(auto &elapsed: elapsed_time_array) {
+	    for(size_t i=0; i<elapsed.first.latency.size(); i++) {
+		auto ph = m_options.profile->phase(elapsed.first.timestamp[i].count() / 1000);
+		if(ph < phases.size()) {
+		    phaselatencies[ph].push_back(elapsed.first.latency[i].count());
+		    if(i < elapsed.first.response.size()) {
+			phaseresponses[ph].push_back(elapsed.first.response[i].count());
 		    }
 		}
 	    }
-	    rv.add_child(thistestcase + "datapoints", datapoints_array);
 	}
 
-	// last error code, useful to identify when something crashes
-	rv.add(thistestcase + "errorcode", errorcode(last_errcode));
+	for(size_t ph=0; ph<phases.size(); ph++) {
+	    const SampleStatistics latencies { std::move(phaselatencies[ph]) };
+	    const SampleStatistics responses { std::move(phaseresponses[ph]) };
+	    std::string phaselabel { "phase #" + i2s(ph) };
+	    std::string phasekey { "phase." + i2s(ph) };
+	    auto n = latencies.count();
+
+	    Measure<> phase_ops(static_cast<double>(n), "Tnx");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", operations", phasekey + ".operations", std::move(phase_ops)));
+	    Measure<> phase_tps(n / phases[ph].duration, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", TPS", phasekey + ".tps", std::move(phase_tps)));
+	    if(n < 2) {
+		continue;	// not enough measures in that phase
+	    }
+
+	    auto phase_avg_err = std::sqrt( latencies.variance() / n ) * 2;
+	    if(phase_avg_err < epsilon) phase_avg_err = epsilon;
+
+	    Measure<> phase_avg(latencies.mean(), phase_avg_err, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", latency, average", phasekey + ".latency.average", std::move(phase_avg)));
+	    Measure<> phase_p99(latencies.percentile(0.99), epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", latency, 99th percentile", phasekey + ".latency.p99", std::move(phase_p99)));
+
+	    // in open-loop mode, queueing shows in the corrected latency: it builds up during bursts,
+	    // and takes time to drain afterwards
+	    if(responses.count() == n) {
+		Measure<> phase_response_avg(responses.mean(), std::max(std::sqrt(responses.variance() / n) * 2, epsilon), "ms");
+		result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", latency (corrected), average", phasekey + ".latency.corrected.average", std::move(phase_response_avg)));
+		Measure<> phase_response_p99(responses.percentile(0.99), epsilon, "ms");
+		result_rows.emplace_back(std::forward_as_tuple(phaselabel + ", latency (corrected), 99th percentile", phasekey + ".latency.corrected.p99", std::move(phase_response_p99)));
+	    }
+	}
+    }
+
+    // per thread statistics: merging the samples of all threads hides starvation, when some threads
+    // get much less work done than others. A thread is made of its lanes (see client_index()), and is shown
+    // under its global index, across worker processes. The TPS of a thread is measured over the window in duration-based mode,
+    // otherwise over its own span, from the start of its first operation to the completion of its last one, over all its lanes.
+    // In histogram mode, there are no timestamps, and the TPS of a thread is derived from the average latency of each lane instead.
+    // Jain's fairness index, (sum x)^2 / (n . sum x^2), is 1 when all threads have the same TPS, and 1/n when a single one does all the work.
+    std::vector<std::tuple<size_t, size_t, double, double, double> > thread_rows; // thread, operations, TPS, latency average, p99
+    if(clients > 1 && std::holds_alternative<benchmark_result::Ok>(last_errcode) && stats_count > 0) {
+	std::map<size_t, std::vector<size_t> > threadlanes; // lanes of each thread, by global index
+	for(size_t th=0; th<static_cast<size_t>(numthreads); th++) {
+	    threadlanes[measurement.threads[th]].push_back(th);
+	}
+
+	double sum = 0.0, sumsq = 0.0;
+	double lowest = std::numeric_limits<double>::max(), highest = 0.0;
+
+	for(auto &[thread, lanes]: threadlanes) {
+	    size_t n = 0;
+	    double tps = 0.0, start = std::numeric_limits<double>::max(), end = 0.0;
+	    std::vector<double> values;
+	    std::optional<Histogram> thread_histogram;
+	    if(histogram) {
+		thread_histogram.emplace(*m_options.histogram);
+	    }
+	    for(auto lane: lanes) {
+		auto &records = elapsed_time_array[lane].first;
+		if(records.histogram) {
+		    n += records.histogram->count();
+		    tps += records.histogram->mean() > 0 ? 1000 / records.histogram->mean() : 0.0;
+		    thread_histogram->merge(*records.histogram);
+		    continue;
+		}
+		n += records.latency.size();
+		for(auto &it: records.latency) {
+		    values.push_back(it.count());
+		}
+		if(!records.timestamp.empty()) {
+		    start = std::min(start, records.timestamp[0].count());
+		    end = std::max(end, records.completion[records.completion.size()-1].count());
+		}
+	    }
+	    const SampleStatistics latencies { std::move(values) };
+
+	    if(m_options.window) {
+		tps = n / std::chrono::duration<double>(m_options.window->duration).count();
+	    } else if(!thread_histogram) {
+		tps = end > start ? 1000 * n / (end - start) : 0.0;
+	    }
+	    auto avg = thread_histogram ? thread_histogram->mean() : latencies.mean();
+	    auto p99 = thread_histogram ? thread_histogram->percentile(0.99) : latencies.percentile(0.99);
+
+	    thread_rows.emplace_back(thread, n, tps, avg, p99);
+	    sum += tps;
+	    sumsq += tps * tps;
+	    lowest = std::min(lowest, tps);
+	    highest = std::max(highest, tps);
+	}
+
+	if(sumsq > 0) {
+	    Measure<> jain(sum * sum / (threadlanes.size() * sumsq), "");
+	    result_rows.emplace_back(std::forward_as_tuple("fairness, Jain's index", "fairness.jain", std::move(jain)));
+	    Measure<> ratio(lowest / highest, "");
+	    result_rows.emplace_back(std::forward_as_tuple("fairness, TPS/thread lowest/highest", "fairness.ratio", std::move(ratio)));
+	}
+    }
+
+    // time series: operations are bucketed per interval of their completion time (measured from the origin),
+    // to reveal what whole-run figures hide, e.g. throttling, pauses or failovers. The completion time is
+    // recorded on the same clock as the start of the operation: the latency, taken with the selected timer
+    // and net of its read overhead, would misplace operations near the edge of an interval.
+    // The first and last intervals are only partly covered, so their TPS is computed over the covered part.
+    ptree timeseries;
+    std::vector<double> interval_tps, interval_p99;
+    if(m_options.interval.count() > 0 && std::holds_alternative<benchmark_result::Ok>(last_errcode) && stats_count > 0 && !histogram) {
+	const double interval = m_options.interval.count();
+	double first = std::numeric_limits<double>::max(), last = 0.0;
+	std::map<long, std::vector<double> > buckets;
+
+	for(auto &elapsed: elapsed_time_array) {
+	    auto &records = elapsed.first;
+	    for(size_t i=0; i<records.latency.size(); i++) {
+		auto completed = records.completion[i].count();
+		first = std::min(first, records.timestamp[i].count());
+		last = std::max(last, completed);
+		buckets[static_cast<long>(completed / interval)].push_back(records.latency[i].count());
+	    }
+	}
+
+	// without per-operation records there is no interval, whatever the command line allowed
+	if(!buckets.empty()) {
+	    for(long b = static_cast<long>(first / interval); b <= static_cast<long>(last / interval); b++) {
+		const SampleStatistics latencies { std::move(buckets[b]) };
+		auto covered = std::min((b + 1) * interval, last) - std::max(b * interval, first);
+		auto n = latencies.count();
+		double tps = covered > 0 ? 1000 * n / covered : 0.0;
+		double p99 = latencies.percentile(0.99);
+
+		ptree point;
+		point.put("start", b * interval);
+		point.put("operations", n);
+		point.put("tps", tps);
+		point.put("latency.average", latencies.mean());
+		point.put("latency.p99", p99);
+		timeseries.push_back(std::make_pair("", point));
+
+		interval_tps.push_back(tps);
+		interval_p99.push_back(p99);
+	    }
+
+	    auto [lowest, highest] = std::minmax_element(interval_tps.begin(), interval_tps.end());
+	    Measure<> tps_min(*lowest, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple("TPS per interval, minimum", "timeseries.tps.minimum", std::move(tps_min)));
+	    Measure<> tps_max(*highest, "Tnx/s");
+	    result_rows.emplace_back(std::forward_as_tuple("TPS per interval, maximum", "timeseries.tps.maximum", std::move(tps_max)));
+	    Measure<> p99_max(*std::max_element(interval_p99.begin(), interval_p99.end()), epsilon, "ms");
+	    result_rows.emplace_back(std::forward_as_tuple("latency, 99th percentile per interval, maximum", "timeseries.latency.p99.maximum", std::move(p99_max)));
+	}
+    }
+
+    // datapoint stream: operations dropped because the writer could not keep up are counted
+    // (the parent of worker processes has no stream, and reports drops only if any)
+    size_t dropped = 0;
+    for(auto &elapsed: elapsed_time_array) {
+	dropped += elapsed.first.dropped;
+    }
+    if(m_options.stream || dropped > 0) {
+	Measure<> dropped_datapoints(static_cast<double>(dropped), "Tnx");
+	result_rows.emplace_back(std::forward_as_tuple("datapoints streamed, dropped", "datapoints.dropped", std::move(dropped_datapoints)));
+    }
+
+    // wallclock_elapsed_ms is the total time elapsed (in ms).
+    Measure<> wallclock_elapsed_ms( wallclock_elapsed.count(), epsilon, "ms" );
+    result_rows.emplace_back(std::forward_as_tuple("wall clock", "wallclock", std::move(wallclock_elapsed_ms)));
+
+    ConsoleTable results{"measure", "value", "error (+/-)", "unit", "rel. error" };
+    results.setStyle(1);
+
+    for(auto &row: result_rows) {
+	results += {
+	    std::get<0>(row),
+		d2s(std::get<2>(row).value(),12),
+		d2s(std::get<2>(row).error(),12),
+		std::get<2>(row).unit(),
+		d2s(std::get<2>(row).relerr()*100,3)+'%'  };
+    }
+
+    std::cout << "Test case results:\n" << results << std::endl;
+
+    if(!thread_rows.empty()) {
+	ConsoleTable threads{"thread", "operations", "TPS (Tnx/s)", "latency, average (ms)", "latency, p99 (ms)" };
+	threads.setStyle(1);
+
+	for(auto &[th, n, tps, avg, p99]: thread_rows) {
+	    threads += { i2s(th), i2s(n), d2s(tps,6), d2s(avg,6), d2s(p99,6) };
+	}
+
+	std::cout << "Per-thread results:\n" << threads << std::endl;
+    }
+
+    if(!interval_tps.empty()) {
+	std::cout << "Time series, per " << d2s(m_options.interval.count()) << " ms (" << interval_tps.size() << " intervals):\n"
+		  << "  TPS         |" << sparkline(interval_tps) << "|\n"
+		  << "  latency p99 |" << sparkline(interval_p99) << "|\n" << std::endl;
+    }
+
+    // now create json output
+    std::string thistestcase { prefix + label + '.' + testcase + '.' };
+
+    // adding facts information
+    for(auto &row: fact_rows) {
+	rv.add(thistestcase + std::get<1>(row), std::get<2>(row) );
+    }
+
+    // adding results information
+    for(auto &row: result_rows) {
+	rv.add<double>(thistestcase + std::get<1>(row) + ".value",  std::get<2>(row).value());
+	rv.add(thistestcase + std::get<1>(row) + ".unit",   std::get<2>(row).unit());
+	rv.add(thistestcase + std::get<1>(row) + ".error",  d2s(std::get<2>(row).error()));
+	rv.add(thistestcase + std::get<1>(row) + ".relerr", d2s(std::get<2>(row).relerr()));
+    }
+
+    // adding the confidence intervals of percentiles
+    for(auto &[key, lower, upper, complete]: percentile_cis) {
+	rv.add(thistestcase + key + ".ci.lower", lower);
+	rv.add(thistestcase + key + ".ci.upper", upper);
+	rv.add(thistestcase + key + ".ci.complete", complete ? "yes" : "no");
+    }
+
+    // adding bootstrap intervals, if any
+    for(auto &[key, lower, upper]: bootstrap_cis) {
+	rv.add(thistestcase + key + ".bootstrap.lower", lower);
+	rv.add(thistestcase + key + ".bootstrap.upper", upper);
+    }
+
+    // adding measured datapoints if requested
+    if(m_options.include_datapoints) {
+	ptree datapoints_array;
+	for(auto &elapsed: elapsed_time_array) {
+	    if(std::holds_alternative<benchmark_result::Ok>(elapsed.second)) {
+		for(auto &it: elapsed.first.latency) {
+		    ptree datapoint;
+		    datapoint.put("", it.count());
+		    datapoints_array.push_back(std::make_pair("", datapoint));
+		}
+	    }
+	}
+	rv.add_child(thistestcase + "datapoints", datapoints_array);
+    }
+
+    // adding per thread results
+    for(auto &[th, n, tps, avg, p99]: thread_rows) {
+	std::string threadkey { thistestcase + "thread." + i2s(th) + '.' };
+	rv.add(threadkey + "operations", n);
+	rv.add(threadkey + "tps", tps);
+	rv.add(threadkey + "latency.average", avg);
+	rv.add(threadkey + "latency.p99", p99);
+    }
+
+    // adding time series if requested
+    if(!timeseries.empty()) {
+	rv.add(thistestcase + "timeseries.interval", d2s(m_options.interval.count()));
+	rv.add_child(thistestcase + "timeseries.points", timeseries);
+    }
+
+    // last error code, useful to identify when something crashes
+    rv.add(thistestcase + "errorcode", errorcode(last_errcode));
+
+    if(!std::holds_alternative<benchmark_result::Ok>(last_errcode)) {
+	return 0.0;
+    }
+
+    // returns the global TPS, preferably as measured over the time window
+    return m_options.window ? stats_count / std::chrono::duration<double>(m_options.window->duration).count() : tps_global_avg_val;
+}
+
+
+ptree Executor::benchmark( P11Benchmark &benchmark, const size_t iter, const size_t skipiter, const std::forward_list<std::string> shortlist )
+{
+    ptree rv;
+
+    // make a copy of the benchmark object for each worker thread.
+    // clones are kept across all test vectors of the benchmark.
+    std::vector<std::unique_ptr<P11Benchmark> > clones(m_numthreads * m_options.queuedepth);
+    for(auto &clone: clones) {
+	clone.reset(benchmark.clone());
+    }
+
+    // with a single number of threads, results are recorded directly under the key label.
+    // Otherwise, they are grouped per number of threads, and a scalability model is fitted
+    // on the global TPS obtained for each group.
+    const bool sweep = m_threadcounts.size() > 1;
+
+    for(auto testcase: shortlist) {
+	std::vector<std::pair<double,double> > points;
+
+	for(auto numthreads: m_threadcounts) {
+	    std::vector<P11Benchmark *> workers;
+	    for(size_t th=0; th<numthreads * m_options.queuedepth; th++) {
+		workers.push_back(clones[th].get());
+	    }
+	    auto measurement = sample( workers, testcase, iter, skipiter );
+
+	    // in a worker process, measurements are sent to the parent, that reports them
+	    if(m_options.processes) {
+		m_options.processes->send( encode( benchmark.name(), benchmark.label(), testcase, measurement ) );
+		continue;
+	    }
+
+	    std::string prefix { sweep ? i2s(numthreads) + " thread-s." : "" };
+	    auto tps = report( benchmark.name(), benchmark.label(), testcase, iter, skipiter, measurement, rv, prefix );
+	    if(tps > 0) {
+		points.emplace_back(numthreads, tps);
+	    }
+	}
+
+	if(sweep && !m_options.processes) {
+	    scalability( benchmark.name(), benchmark.label(), testcase, points, rv );
+	}
+    }
+
+    return rv;
+}
+
+std::vector<std::pair<std::string, ptree> > Executor::aggregate( const size_t iter, const size_t skipiter )
+{
+    std::vector<std::pair<std::string, ptree> > rv;
+    std::map<std::string, std::vector<std::pair<double,double> > > points; // per benchmark and test case, for sweeps
+    std::vector<std::string> records;
+    const bool sweep = m_threadcounts.size() > 1;
+
+    try {
+	// workers run the same sequence of test cases, each record set matches one test case run
+	while(m_options.processes->receive(records)) {
+	    Measurement merged;
+	    std::string name, label, testcase;
+
+	    for(size_t i=0; i<records.size(); i++) {
+		Measurement measurement;
+		std::string n, l, t;
+		decode( records[i], n, l, t, measurement );
+
+		if(i==0) {
+		    name = n; label = l; testcase = t;
+		} else if(n != name || l != label || t != testcase || measurement.results.size() != merged.results.size() / i) {
+		    throw std::runtime_error("worker processes are out of step");
+		}
+
+		std::move(measurement.results.begin(), measurement.results.end(), std::back_inserter(merged.results));
+		merged.threads.insert(merged.threads.end(), measurement.threads.begin(), measurement.threads.end());
+		merged.wallclock = std::max(merged.wallclock, measurement.wallclock);
+		merged.operations = measurement.operations;
+	    }
+
+	    std::string key { name + " using " + label };
+	    if(rv.empty() || rv.back().first != key) {
+		rv.emplace_back(key, ptree());
+	    }
+	    auto &tree = rv.back().second;
+
+	    auto totalthreads = merged.results.size() / m_options.queuedepth;
+	    auto numthreads = static_cast<int>(totalthreads / records.size());
+	    std::string prefix { sweep ? i2s(totalthreads) + " thread-s." : "" };
+	    auto tps = report( name, label, testcase, iter, skipiter, merged, tree, prefix );
+
+	    if(sweep) {
+		auto &testcase_points = points[key + '.' + testcase];
+		if(tps > 0) {
+		    testcase_points.emplace_back(totalthreads, tps);
+		}
+		if(numthreads == m_threadcounts.back()) { // last run of the sweep for that test case
+		    scalability( name, label, testcase, testcase_points, tree );
+		}
+	    }
+	}
+    } catch(...) {
+	m_options.processes->abort();
+	throw;
+    }
+
+    return rv;
+}
+
+std::vector<std::pair<std::string, ptree> > Executor::concurrent( const std::vector<std::pair<P11Benchmark *, int> > &groups, const size_t iter, const size_t skipiter, const std::forward_list<std::string> shortlist )
+{
+    std::vector<std::pair<std::string, ptree> > rv;
+
+    // groups take the worker threads in turn, each worker receiving a clone of the benchmark of its group.
+    // clones are kept across all test vectors.
+    std::vector<std::unique_ptr<P11Benchmark> > clones;
+    std::vector<size_t> firsts;	// first worker of each group, followed by the number of workers
+    for(auto &[benchmark, numthreads]: groups) {
+	firsts.push_back(clones.size());
+	for(int th=0; th<numthreads; th++) {
+	    clones.emplace_back(benchmark->clone());
+	}
+	rv.emplace_back(benchmark->name() + " using " + benchmark->label(), ptree());
+    }
+    firsts.push_back(clones.size());
+
+    if(clones.size() > static_cast<size_t>(m_numthreads)) {
+	throw std::invalid_argument("the groups need " + i2s(clones.size()) + " threads, while only " + i2s(m_numthreads) + " are available");
+    }
+
+    // workers(): the clones of a group, or of all groups; the workers of the other groups stay idle
+    auto workers = [&](std::optional<size_t> group) {
+	std::vector<P11Benchmark *> selection(clones.size(), nullptr);
+	for(size_t th=0; th<clones.size(); th++) {
+	    if(!group || (th >= firsts[*group] && th < firsts[*group+1])) {
+		selection[th] = clones[th].get();
+	    }
+	}
+	return selection;
+    };
+
+    for(auto testcase: shortlist) {
+	// baseline: each group runs alone, on the same threads (and sessions) as when run concurrently
+	std::vector<Measurement> solo;
+	for(size_t g=0; g<groups.size(); g++) {
+	    solo.push_back( measure( workers(g), testcase, iter, skipiter ) );
+	}
+
+	// then all groups run together; the measurement is split per group
+	auto together = measure( workers(std::nullopt), testcase, iter, skipiter );
+
+	for(size_t g=0; g<groups.size(); g++) {
+	    auto benchmark = groups[g].first;
+
+	    Measurement part;
+	    part.wallclock = together.wallclock;
+	    part.operations = solo[g].operations;
+	    for(size_t th=firsts[g]; th<firsts[g+1]; th++) {
+		part.results.push_back(std::move(together.results[th]));
+		part.threads.push_back(together.threads[th]);
+	    }
+
+	    std::string others;
+	    for(size_t o=0; o<groups.size(); o++) {
+		if(o != g) {
+		    others += (others.empty() ? "" : ", ") + groups[o].first->name() + " using " + groups[o].first->label() + " (" + i2s(groups[o].second) + " thread-s)";
+		}
+	    }
+
+	    auto &tree = rv[g].second;
+	    std::cout << "Group #" << g << ", alone:\n\n";
+	    auto solotps = report( benchmark->name(), benchmark->label(), testcase, iter, skipiter, solo[g], tree, "solo." );
+	    std::cout << "Group #" << g << ", concurrent with " << others << ":\n\n";
+	    auto togethertps = report( benchmark->name(), benchmark->label(), testcase, iter, skipiter, part, tree, "" );
+	    interference( benchmark->name(), benchmark->label(), testcase, solo[g], solotps, part, togethertps, others, tree );
+	}
     }
 
     return rv;
 }
+
+// interference(): ratios between the figures of a group run concurrently with other groups, and run alone
+void Executor::interference( const std::string &name, const std::string &label, const std::string &testcase, const Measurement &solo, double solotps, const Measurement &together, double togethertps, const std::string &others, ptree &rv )
+{
+    std::vector<std::tuple<std::string, std::string, Measure<>>> result_rows;
+
+    std::vector<std::tuple<std::string, std::string, std::string>> fact_rows {
+	{ "algorithm", "algorithm", name },
+	{ "vector size", "vector.size", i2s(m_vectors.at(testcase).size()) },
+	{ "key label", "label", label },
+	{ "number of threads", "threads", i2s(together.results.size()) },
+	{ "concurrent with", "concurrent", others },
+	{ "compared TPS", "measure", m_options.window ? "tps.measured" : "tps.global" }
+    };
+
+    // a ratio above 1 on latency (below 1 on TPS) is the slowdown caused by the other groups
+    if(solotps > 0 && togethertps > 0) {
+	auto [solo_avg, solo_p99] = latency_summary(solo);
+	auto [together_avg, together_p99] = latency_summary(together);
+	result_rows.emplace_back(std::forward_as_tuple("latency, average, concurrent/alone", "latency.average", Measure<>(together_avg / solo_avg, "")));
+	result_rows.emplace_back(std::forward_as_tuple("latency, 99th percentile, concurrent/alone", "latency.p99", Measure<>(together_p99 / solo_p99, "")));
+	result_rows.emplace_back(std::forward_as_tuple("global TPS, concurrent/alone", "tps", Measure<>(togethertps / solotps, "")));
+    }
+
+    ConsoleTable facts { "property", "value" };
+    facts.setStyle(1);
+
+    for(auto &row: fact_rows) {
+	facts += { std::get<0>(row), std::get<2>(row) };
+    }
+
+    ConsoleTable results{"measure", "value", "unit" };
+    results.setStyle(1);
+
+    for(auto &row: result_rows) {
+	results += { std::get<0>(row), d2s(std::get<2>(row).value(),6), std::get<2>(row).unit() };
+    }
+
+    std::cout << name + " with key " + label + ", interference" << '\n'
+	      << "================================================================================\n"
+	      << "Interference facts:\n"
+	      << facts << '\n'
+	      << "Interference ratios:\n";
+    if(result_rows.empty()) {
+	std::cout << "a run failed, no ratio can be computed\n" << std::endl;
+    } else {
+	std::cout << results << std::endl;
+    }
+
+    // now create json output
+    std::string thistestcase { "interference." + label + '.' + testcase + '.' };
+
+    for(auto &row: fact_rows) {
+	rv.add(thistestcase + std::get<1>(row), std::get<2>(row) );
+    }
+
+    for(auto &row: result_rows) {
+	rv.add<double>(thistestcase + std::get<1>(row) + ".value",  std::get<2>(row).value());
+	rv.add(thistestcase + std::get<1>(row) + ".unit",   std::get<2>(row).unit());
+    }
+}
+
+// scalability(): fit Amdahl's law and USL over the global TPS obtained for each number of threads
+void Executor::scalability( const std::string &name, const std::string &label, const std::string &testcase, const std::vector<std::pair<double,double> > &points, ptree &rv )
+{
+    std::vector<std::tuple<std::string, std::string, Measure<>>> result_rows;
+
+    std::string counts;
+    for(auto &point: points) {
+	counts += (counts.empty() ? "" : ",") + i2s(static_cast<long>(point.first));
+    }
+
+    std::vector<std::tuple<std::string, std::string, std::string>> fact_rows {
+	{ "algorithm", "algorithm", name },
+	{ "vector size", "vector.size", i2s(m_vectors.at(testcase).size()) },
+	{ "key label", "label", label },
+	{ "numbers of threads", "threads", counts },
+	{ "fitted measure", "measure", m_options.window ? "tps.measured" : "tps.global" }
+    };
+
+    // Amdahl's law needs two points, USL three
+    if(points.size() >= 2) {
+	auto amdahl = fit_amdahl(points);
+	result_rows.emplace_back(std::forward_as_tuple("Amdahl, single thread TPS", "amdahl.lambda", Measure<>(amdahl.lambda, "Tnx/s")));
+	result_rows.emplace_back(std::forward_as_tuple("Amdahl, contention (sigma)", "amdahl.sigma", Measure<>(amdahl.sigma, "")));
+	if(amdahl.sigma > 0) {
+	    result_rows.emplace_back(std::forward_as_tuple("Amdahl, TPS asymptote", "amdahl.asymptote", Measure<>(amdahl.lambda / amdahl.sigma, "Tnx/s")));
+	}
+	result_rows.emplace_back(std::forward_as_tuple("Amdahl, coefficient of determination", "amdahl.r2", Measure<>(amdahl.r2, "")));
+    }
+
+    if(points.size() >= 3) {
+	auto usl = fit_usl(points);
+	result_rows.emplace_back(std::forward_as_tuple("USL, single thread TPS", "usl.lambda", Measure<>(usl.lambda, "Tnx/s")));
+	result_rows.emplace_back(std::forward_as_tuple("USL, contention (sigma)", "usl.sigma", Measure<>(usl.sigma, "")));
+	result_rows.emplace_back(std::forward_as_tuple("USL, coherency (kappa)", "usl.kappa", Measure<>(usl.kappa, "")));
+	if(auto peak = usl.peak_concurrency()) {
+	    result_rows.emplace_back(std::forward_as_tuple("USL, peak number of threads", "usl.peak.threads", Measure<>(*peak, "threads")));
+	    result_rows.emplace_back(std::forward_as_tuple("USL, peak TPS", "usl.peak.tps", Measure<>(usl.throughput(*peak), "Tnx/s")));
+	}
+	result_rows.emplace_back(std::forward_as_tuple("USL, coefficient of determination", "usl.r2", Measure<>(usl.r2, "")));
+    }
+
+    ConsoleTable facts { "property", "value" };
+    facts.setStyle(1);
+
+    for(auto &row: fact_rows) {
+	facts += { std::get<0>(row), std::get<2>(row) };
+    }
+
+    ConsoleTable results{"measure", "value", "unit" };
+    results.setStyle(1);
+
+    for(auto &row: result_rows) {
+	results += { std::get<0>(row), d2s(std::get<2>(row).value(),6), std::get<2>(row).unit() };
+    }
+
+    std::cout << name + " with key " + label + ", scalability" << '\n'
+	      << "================================================================================\n"
+	      << "Scalability facts:\n"
+	      << facts << '\n'
+	      << "Scalability model:\n";
+    if(result_rows.empty()) {
+	std::cout << "not enough successful runs to fit a model\n" << std::endl;
+    } else {
+	std::cout << results << std::endl;
+    }
+
+    // now create json output
+    std::string thistestcase { "scalability." + label + '.' + testcase + '.' };
+
+    for(auto &row: fact_rows) {
+	rv.add(thistestcase + std::get<1>(row), std::get<2>(row) );
+    }
+
+    for(auto &row: result_rows) {
+	rv.add<double>(thistestcase + std::get<1>(row) + ".value",  std::get<2>(row).value());
+	rv.add(thistestcase + std::get<1>(row) + ".unit",   std::get<2>(row).unit());
+    }
+}
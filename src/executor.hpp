@@ -25,39 +25,129 @@
 #include <botan/p11_types.h>
 #include <boost/property_tree/ptree.hpp>
 #include "p11benchmark.hpp"
+#include "barrier.hpp"
+#include "workerpool.hpp"
+#include "processgroup.hpp"
+#include "sessionpool.hpp"
+#include "threadcoverage.hpp"
+#include "cpuaffinity.hpp"
+#include "loadprofile.hpp"
+#include "datapointwriter.hpp"
 #include "units.hpp"
 #include "../config.h"
 
 using namespace Botan::PKCS11;
 using namespace boost::property_tree;
 
+// raw outcome of a test case run, for all threads (possibly gathered from several worker processes)
+struct Measurement {
+    std::vector<benchmark_result::benchmark_result_t> results; // one entry per thread
+    std::vector<std::size_t> threads;	// global index of each thread, across worker processes
+    milliseconds_double_t wallclock {0};
+    std::vector<std::string> operations; // operations of a mixed workload, if any
+    size_t batches {0};		// number of batches of iterations, for adaptive runs
+};
+
+// target precision, for adaptive runs: batches of iterations are run until the relative error on the average latency
+// (and optionally on the 99th percentile) is within the target, or until maxiter iterations per thread are reached
+struct Target {
+    double relerr;
+    bool p99;
+    size_t maxiter;
+};
+
+// run options of an executor, given by the command line. The defaults make a closed-loop run
+// of a fixed number of iterations, each thread with its own session.
+struct ExecutorOptions {
+    bool generate_session_keys {false};
+    bool include_datapoints {false}; // measured points are added to the results
+    double rate {0.0};		// target arrival rate (Tnx/s) for open-loop mode, 0 for closed-loop
+    std::optional<TimeWindow> window; // measurement window, for duration-based runs
+    CpuAffinity affinity {"none"}; // placement of worker threads
+    std::vector<int> threadslots; // slot index of the session of each thread, by global index
+    size_t sharedsessions {0};	// size of the session pool of each slot, 0 when each thread has its own session
+    std::vector<SessionPool *> threadpools; // session pool of each thread, if any
+    std::optional<LoadProfile> profile; // time-varying load, if any
+    std::optional<Target> target; // target precision, for adaptive runs
+    bool autoskip {false};	// the warm-up of each thread is detected and trimmed, instead of skipping iterations
+    milliseconds_double_t interval {0}; // interval of the time series, 0 when disabled
+    size_t queuedepth {1};	// operations in flight per thread, each run by its own lane
+    std::optional<int> histogram; // significant digits of the latency histograms, in histogram mode
+    std::vector<double> percentiles { 95, 98, 99 }; // percentiles of latency to report, in percent
+    size_t resamples {0};	// number of bootstrap resamples, 0 when disabled
+    std::optional<std::string> baseline; // benchmark (as "name using label") run first as null-operation baseline, if any
+    bool breakdown {false};	// init, operation and cleanup phases are timed apart
+    DatapointWriter *stream {nullptr}; // stream of datapoints, if any
+    ProcessGroup *processes {nullptr}; // worker processes, if any
+};
+
 class Executor
 {
     const std::map<const std::string, const std::vector<uint8_t> > &m_vectors;
     std::vector<std::unique_ptr<Session> > &m_sessions;
-    const int m_numthreads;
+    const std::vector<int> m_threadcounts; // numbers of threads to run each test case with
+    const int m_numthreads;	// largest number of threads, i.e. size of the worker pool
     nanoseconds_double_t m_timer_res;
     nanoseconds_double_t m_timer_res_err;
-    bool m_generate_session_keys;
-    bool m_include_datapoints;
+    const ExecutorOptions m_options; // run options, see ExecutorOptions
+    std::map<int, std::pair<double, double> > m_baselines; // average latency of the baseline and its error (ms), per number of threads
+    Barrier m_start;		// all worker threads start together
+    WorkerPool m_pool;		// long-lived worker threads, one per session (i.e. per lane)
+
+    // place_threads(): bind each worker thread according to the affinity policy
+    void place_threads();
+
+    // global_index(): index of a thread across all worker processes.
+    // Threads are interleaved, so that the first threads of all processes come first, whatever their number.
+    inline size_t global_index(size_t th) const { return m_options.processes ? th * m_options.processes->size() + m_options.processes->index() : th; }
+
+    // client_index(): global index of the thread a worker runs a lane of. With a queue depth of K, each thread
+    // is made of K consecutive workers (lanes), sharing its slot and CPU placement.
+    inline size_t client_index(size_t worker) const { return global_index(worker / m_options.queuedepth); }
+
+    // open_loop(): whether operations are fired on a timetable, at a constant rate or following a load profile
+    inline bool open_loop() const { return m_options.rate > 0 || (m_options.profile && m_options.profile->unit() == LoadProfile::Unit::rate); }
+
+    // measure(): run a test case, each worker thread running its own benchmark clone.
+    // Workers given no clone (nullptr) stay idle, as well as those beyond the size of clones.
+    // For adaptive runs, batch is the number of the batch, from 1 (0 otherwise).
+    Measurement measure( const std::vector<P11Benchmark *> &clones, const std::string &testcase, const size_t iter, const size_t skipiter, const size_t batch = 0 );
+
+    // sample(): run a test case once, or for adaptive runs, in batches of iter iterations until the target precision is reached
+    Measurement sample( const std::vector<P11Benchmark *> &clones, const std::string &testcase, const size_t iter, const size_t skipiter );
+
+    // report(): compute statistics over a measurement, print them and record them in rv, under prefix.
+    // returns the global TPS, or 0 if the test case failed.
+    double report( const std::string &name, const std::string &label, const std::string &testcase, const size_t iter, const size_t skipiter, Measurement &measurement, ptree &rv, const std::string &prefix );
+
+    // scalability(): fit scalability models over (number of threads, global TPS) points, print and record them in rv
+    void scalability( const std::string &name, const std::string &label, const std::string &testcase, const std::vector<std::pair<double,double> > &points, ptree &rv );
+
+    // interference(): compare a group of threads run concurrently with other groups to its solo baseline, print and record the ratios in rv
+    void interference( const std::string &name, const std::string &label, const std::string &testcase, const Measurement &solo, double solotps, const Measurement &together, double togethertps, const std::string &others, ptree &rv );
 
 public:
     Executor( const std::map<const std::string,
 	      const std::vector<uint8_t> > &vectors,
 	      std::vector<std::unique_ptr<Session> > &sessions,
-	      const int numthreads,
+	      const ThreadCoverage &threads,
 	      std::pair<nanoseconds_double_t, nanoseconds_double_t> precision,
-	      bool generate_session_keys,
-	      bool include_datapoints = false)
+	      const ExecutorOptions &options)
 	:
 	m_vectors(vectors),
 	m_sessions(sessions),
-	m_numthreads(numthreads),
+	m_threadcounts(threads.begin(), threads.end()),
+	m_numthreads(threads.max()),
 	m_timer_res(precision.first),
 	m_timer_res_err(precision.second),
-	m_generate_session_keys(generate_session_keys),
-	m_include_datapoints(include_datapoints)
-    { }
+	m_options(options),
+	// in a worker process, the start barrier also waits for the other worker processes
+	m_start(m_numthreads * m_options.queuedepth, m_options.processes && !m_options.processes->is_parent() ? std::function<void()>([processes = m_options.processes] { processes->arrive_and_wait(); }) : nullptr),
+	// the parent of worker processes only reports, and needs no thread
+	m_pool(m_options.processes && m_options.processes->is_parent() ? 0 : m_numthreads * m_options.queuedepth)
+    {
+	place_threads();
+    }
 
     Executor( const Executor &) = delete;
     Executor& operator=( const Executor &) = delete;
@@ -67,8 +157,18 @@ public:
 
     double precision() { return (m_timer_res + m_timer_res_err).count(); }
 
+    // benchmark(): run and report all test cases of a benchmark.
+    // In a worker process, measurements are sent to the parent instead, and the returned tree is empty.
     ptree benchmark( P11Benchmark &benchmark, const size_t iter, const size_t skipiter, const std::forward_list<std::string> shortlist );
 
+    // aggregate(): in the parent of worker processes, merge the measurements received from the workers,
+    // and report them as if they came from a single process. Results are returned per benchmark, in order.
+    std::vector<std::pair<std::string, ptree> > aggregate( const size_t iter, const size_t skipiter );
+
+    // concurrent(): run several benchmarks at the same time, each on its own group of threads (given as benchmark, number of threads),
+    // after running each group alone on the same threads, as a baseline. Results are returned per group, in order.
+    std::vector<std::pair<std::string, ptree> > concurrent( const std::vector<std::pair<P11Benchmark *, int> > &groups, const size_t iter, const size_t skipiter, const std::forward_list<std::string> shortlist );
+
 };
 
 
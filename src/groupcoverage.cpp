@@ -0,0 +1,74 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// groupcoverage.cpp: a class to handle groups of threads running different test cases concurrently
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/tokenizer.hpp>
+#include "groupcoverage.hpp"
+
+GroupCoverage::GroupCoverage(std::string tocover)
+{
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > toparse(tocover, sep);
+
+    for(auto token : toparse) {
+	auto colon = token.find(':');
+	char *next = nullptr;
+	long threads = 0;
+
+	if(colon != std::string::npos) {
+	    threads = std::strtol(token.c_str() + colon + 1, &next, 10);
+	}
+
+	if(colon == std::string::npos || colon == 0 || next == token.c_str() + colon + 1 || *next != '\0' || threads <= 0) {
+	    std::cerr << "Invalid group: " << token << ", skipping." << std::endl;
+	    continue;
+	}
+
+	auto testcase = token.substr(0, colon);
+	auto found = std::find_if(m_entries.begin(), m_entries.end(), [&](auto &entry) { return entry.first == testcase; });
+	if(found != m_entries.end()) {
+	    std::cerr << "Test case " << testcase << " specified in more than one group, skipping." << std::endl;
+	    continue;
+	}
+
+	m_entries.emplace_back(testcase, static_cast<int>(threads));
+    }
+}
+
+std::string GroupCoverage::tests() const
+{
+    std::string rv;
+    for(auto &entry: m_entries) {
+	rv += (rv.empty() ? "" : ",") + entry.first;
+    }
+    return rv;
+}
+
+int GroupCoverage::threads() const
+{
+    int rv = 0;
+    for(auto &entry: m_entries) {
+	rv += entry.second;
+    }
+    return rv;
+}
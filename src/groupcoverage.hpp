@@ -0,0 +1,54 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// groupcoverage.hpp: a class to handle groups of threads running different test cases concurrently
+//
+// Groups are made of comma-separated test cases, each followed by its number of threads, e.g. "rsa:16,aescbc:8".
+// Test cases are named as for the test coverage.
+
+#if !defined(GROUPCOVERAGE_H)
+#define GROUPCOVERAGE_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+class GroupCoverage
+{
+public:
+    GroupCoverage(std::string tocover);
+
+    inline bool empty() const noexcept { return m_entries.empty(); }
+    inline std::size_t size() const noexcept { return m_entries.size(); }
+
+    inline auto begin() const noexcept { return m_entries.begin(); }
+    inline auto end() const noexcept { return m_entries.end(); }
+
+    // tests(): test cases of the groups, as a test coverage string
+    std::string tests() const;
+
+    // threads(): total number of threads, over all groups
+    int threads() const;
+
+private:
+    std::vector<std::pair<std::string, int> > m_entries; // test case, number of threads
+};
+
+
+#endif // GROUPCOVERAGE_H
@@ -0,0 +1,191 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// histogram.cpp: a log-linear histogram of latencies, with bounded memory
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include "histogram.hpp"
+
+Histogram::Histogram(int digits) : m_digits(digits)
+{
+    if(digits < 1 || digits > 5) {
+	throw std::invalid_argument("the precision of histograms must be between 1 and 5 significant digits");
+    }
+    m_bits = static_cast<unsigned>(std::ceil(std::log2(2 * std::pow(10.0, digits))));
+}
+
+size_t Histogram::index(uint64_t value) const
+{
+    const uint64_t exact = uint64_t{1} << m_bits;
+    if(value < exact) {
+	return value;
+    }
+    // above 2^k, the range [2^n, 2^(n+1)[ is counted in half of 2^k sub-buckets, 2^(n-k+1) wide
+    const unsigned shift = 63 - __builtin_clzll(value) - (m_bits - 1);
+    const uint64_t half = exact >> 1;
+    return exact + (shift - 1) * half + ((value >> shift) - half);
+}
+
+uint64_t Histogram::lowest(size_t idx) const
+{
+    const uint64_t exact = uint64_t{1} << m_bits;
+    if(idx < exact) {
+	return idx;
+    }
+    const uint64_t half = exact >> 1;
+    const unsigned shift = (idx - exact) / half + 1;
+    return ((idx - exact) % half + half) << shift;
+}
+
+uint64_t Histogram::width(size_t idx) const
+{
+    const uint64_t exact = uint64_t{1} << m_bits;
+    return idx < exact ? 1 : uint64_t{1} << ((idx - exact) / (exact >> 1) + 1);
+}
+
+void Histogram::record(milliseconds_double_t value)
+{
+    const double ms = value.count() > 0 ? value.count() : 0.0;
+    const uint64_t ns = static_cast<uint64_t>(std::llround(ms * 1e6));
+    const size_t idx = index(ns);
+
+    if(idx >= m_counts.size()) {
+	m_counts.resize(idx + 1, 0);
+    }
+    m_counts[idx]++;
+    m_count++;
+    m_min = std::min(m_min, ns);
+    m_max = std::max(m_max, ns);
+    m_sum += ms;
+    m_sumsq += ms * ms;
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    if(other.m_digits != m_digits) {
+	throw std::invalid_argument("cannot merge histograms of different precisions");
+    }
+    if(other.m_counts.size() > m_counts.size()) {
+	m_counts.resize(other.m_counts.size(), 0);
+    }
+    for(size_t i=0; i<other.m_counts.size(); i++) {
+	m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+    m_sumsq += other.m_sumsq;
+}
+
+double Histogram::min() const
+{
+    return m_count ? m_min / 1e6 : 0.0;
+}
+
+double Histogram::max() const
+{
+    return m_max / 1e6;
+}
+
+double Histogram::mean() const
+{
+    return m_count ? m_sum / m_count : 0.0;
+}
+
+double Histogram::variance() const
+{
+    if(m_count < 2) {
+	return 0.0;
+    }
+    const double n = m_count;
+    return std::max(0.0, (m_sumsq - m_sum * m_sum / n) / (n - 1));
+}
+
+double Histogram::percentile(double p) const
+{
+    return at(static_cast<uint64_t>(std::ceil(p * m_count)));
+}
+
+double Histogram::at(uint64_t rank) const
+{
+    if(m_count == 0) {
+	return 0.0;
+    }
+
+    // the value of a rank lies in the first bucket where the cumulated count reaches it;
+    // the highest value of that bucket is returned, within the recorded range
+    rank = std::clamp<uint64_t>(rank, 1, m_count);
+    uint64_t cumulated = 0;
+    for(size_t i=0; i<m_counts.size(); i++) {
+	cumulated += m_counts[i];
+	if(cumulated >= rank) {
+	    return std::clamp(lowest(i) + width(i) - 1, m_min, m_max) / 1e6;
+	}
+    }
+    return max();
+}
+
+std::vector<std::pair<double, uint64_t> > Histogram::buckets() const
+{
+    std::vector<std::pair<double, uint64_t> > rv;
+    for(size_t i=0; i<m_counts.size(); i++) {
+	if(m_counts[i]) {
+	    rv.emplace_back((lowest(i) + (width(i) - 1) / 2.0) / 1e6, m_counts[i]);
+	}
+    }
+    return rv;
+}
+
+// the serialized form holds the precision, the summary, then the non-empty counters as (index, count) pairs
+void Histogram::serialize(std::vector<uint64_t> &out) const
+{
+    uint64_t sum, sumsq;
+    std::memcpy(&sum, &m_sum, sizeof sum);
+    std::memcpy(&sumsq, &m_sumsq, sizeof sumsq);
+    out.insert(out.end(), { static_cast<uint64_t>(m_digits), m_count, m_min, m_max, sum, sumsq });
+    for(size_t i=0; i<m_counts.size(); i++) {
+	if(m_counts[i]) {
+	    out.push_back(i);
+	    out.push_back(m_counts[i]);
+	}
+    }
+}
+
+Histogram Histogram::deserialize(const std::vector<uint64_t> &in)
+{
+    if(in.size() < 6 || in.size() % 2) {
+	throw std::runtime_error("malformed histogram");
+    }
+    Histogram rv(static_cast<int>(in[0]));
+    rv.m_count = in[1];
+    rv.m_min = in[2];
+    rv.m_max = in[3];
+    std::memcpy(&rv.m_sum, &in[4], sizeof rv.m_sum);
+    std::memcpy(&rv.m_sumsq, &in[5], sizeof rv.m_sumsq);
+    for(size_t i=6; i<in.size(); i+=2) {
+	if(in[i] >= rv.m_counts.size()) {
+	    rv.m_counts.resize(in[i] + 1, 0);
+	}
+	rv.m_counts[in[i]] = in[i+1];
+    }
+    return rv;
+}
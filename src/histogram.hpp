@@ -0,0 +1,88 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// histogram.hpp: a log-linear histogram of latencies, with bounded memory (after HdrHistogram, by G. Tene)
+//
+// Values are recorded in nanoseconds, with a relative precision given as a number of significant decimal digits.
+// Let 2^k be the smallest power of two above 2.10^digits: values below 2^k are counted exactly, and above that,
+// each range [2^n, 2^(n+1)[ is split into 2^(k-1) sub-buckets of equal width. Memory therefore depends on the range
+// of recorded values, and not on their number. Sum and sum of squares are kept apart, so that the mean and variance are exact.
+// Histograms recorded by several threads (or processes) are merged by adding their counts.
+
+#if !defined(HISTOGRAM_H)
+#define HISTOGRAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include "units.hpp"
+
+class Histogram
+{
+    int m_digits;
+    unsigned m_bits;		// k, i.e. 2^k sub-buckets
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count {0};
+    uint64_t m_min {UINT64_MAX};	// ns
+    uint64_t m_max {0};		// ns
+    double m_sum {0};		// ms
+    double m_sumsq {0};		// ms^2
+
+    // index(): index of the counter of a value, in ns
+    size_t index(uint64_t value) const;
+
+    // lowest(), width(): range of values, in ns, counted by a counter
+    uint64_t lowest(size_t idx) const;
+    uint64_t width(size_t idx) const;
+
+public:
+    explicit Histogram(int digits = 3);
+
+    // record(): count a value
+    void record(milliseconds_double_t value);
+
+    // merge(): add the counts of another histogram, with the same precision
+    void merge(const Histogram &other);
+
+    inline int digits() const { return m_digits; }
+    inline uint64_t count() const { return m_count; }
+    inline bool empty() const { return m_count == 0; }
+
+    // statistics, in ms. Mean and variance are exact, minimum and maximum as well.
+    double min() const;
+    double max() const;
+    double mean() const;
+    double variance() const;	// sample variance
+
+    // percentile(): the value below which a fraction p of the values lie, within the precision of the histogram
+    double percentile(double p) const;
+
+    // at(): the value of a given rank (from 1, in increasing order), within the precision of the histogram
+    double at(uint64_t rank) const;
+
+    // buckets(): non-empty buckets, as (middle of the bucket in ms, count)
+    std::vector<std::pair<double, uint64_t> > buckets() const;
+
+    // serialization, to transfer a histogram from a worker process to its parent
+    void serialize(std::vector<uint64_t> &out) const;
+    static Histogram deserialize(const std::vector<uint64_t> &in);
+};
+
+
+#endif // HISTOGRAM_H
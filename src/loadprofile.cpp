@@ -0,0 +1,225 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// loadprofile.cpp: a time-varying load, made of successive phases
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "loadprofile.hpp"
+
+LoadProfile::LoadProfile(const std::string &profile) : m_name(profile)
+{
+    std::vector<Phase> phases;
+    std::optional<Unit> unit;	// set by the first level, all others must match
+
+    parse(profile, phases, unit);
+
+    double start = 0.0;
+    for(auto &phase: phases) {
+	phase.start = start;
+	start += phase.duration;
+    }
+
+    if(phases.empty()) {
+	throw std::invalid_argument("empty load profile: " + profile);
+    }
+
+    m_phases = std::move(phases);
+    m_unit = *unit;
+}
+
+void LoadProfile::parse(const std::string &profile, std::vector<Phase> &phases, std::optional<Unit> &unit)
+{
+    size_t pos = 0;
+
+    auto invalid = [&profile](const std::string &what) {
+	return std::invalid_argument("invalid load profile '" + profile + "': " + what);
+    };
+
+    // level(): parse a level, and check its unit against the other levels
+    auto level = [&](const std::string &token) {
+	char *next = nullptr;
+	double value = std::strtod(token.c_str(), &next);
+	if(next == token.c_str() || value < 0) {
+	    throw invalid("bad level '" + token + "'");
+	}
+	Unit levelunit = Unit::rate;
+	if(*next == 't') {
+	    levelunit = Unit::threads;
+	    next++;
+	}
+	if(*next != '\0') {
+	    throw invalid("bad level '" + token + "'");
+	}
+	if(!unit) {
+	    unit = levelunit;
+	} else if(levelunit != *unit) {
+	    throw invalid("rates and numbers of threads cannot be mixed");
+	}
+	return value;
+    };
+
+    while(pos < profile.size()) {
+	if(profile[pos] == '[') {
+	    // a repeated group: find the matching bracket, then the repetition count
+	    size_t depth = 0, close = pos;
+	    for(; close < profile.size(); close++) {
+		if(profile[close] == '[') depth++;
+		if(profile[close] == ']' && --depth == 0) break;
+	    }
+	    if(close == profile.size() || close+1 == profile.size() || profile[close+1] != '*') {
+		throw invalid("a group must be closed and followed by '*count'");
+	    }
+	    char *next = nullptr;
+	    long count = std::strtol(profile.c_str() + close + 2, &next, 10);
+	    if(next == profile.c_str() + close + 2 || count < 1) {
+		throw invalid("bad repetition count");
+	    }
+
+	    std::vector<Phase> group;
+	    parse(profile.substr(pos+1, close-pos-1), group, unit);
+	    for(long i=0; i<count; i++) {
+		phases.insert(phases.end(), group.begin(), group.end());
+	    }
+	    pos = next - profile.c_str();
+	} else {
+	    auto comma = profile.find(',', pos);
+	    auto token = profile.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+	    pos = comma == std::string::npos ? profile.size() : comma;
+
+	    auto at = token.find('@');
+	    if(at == std::string::npos) {
+		throw invalid("phase '" + token + "' has no duration");
+	    }
+
+	    char *next = nullptr;
+	    auto durationstr = token.substr(at+1);
+	    double duration = std::strtod(durationstr.c_str(), &next);
+	    if(next == durationstr.c_str() || *next != '\0' || !(duration > 0)) {
+		throw invalid("bad duration in phase '" + token + "'");
+	    }
+
+	    auto levels = token.substr(0, at);
+	    auto dash = levels.find('-', 1);
+	    double from = level(levels.substr(0, dash));
+	    double to = dash == std::string::npos ? from : level(levels.substr(dash+1));
+
+	    phases.push_back( Phase { from, to, 0.0, duration } );
+	}
+
+	if(pos < profile.size()) {
+	    if(profile[pos] != ',') {
+		throw invalid("phases must be separated by commas");
+	    }
+	    pos++;
+	}
+    }
+}
+
+double LoadProfile::duration() const
+{
+    return m_phases.back().start + m_phases.back().duration;
+}
+
+double LoadProfile::peak() const
+{
+    double rv = 0.0;
+    for(auto &phase: m_phases) {
+	rv = std::max( { rv, phase.from, phase.to } );
+    }
+    return rv;
+}
+
+std::string LoadProfile::describe(size_t phase) const
+{
+    auto &p = m_phases.at(phase);
+    std::ostringstream rv;
+    rv << p.from;
+    if(p.to != p.from) {
+	rv << " to " << p.to;
+    }
+    rv << (m_unit == Unit::rate ? " Tnx/s" : " thread(s)") << " for " << p.duration << " s";
+    return rv.str();
+}
+
+size_t LoadProfile::phase(double t) const
+{
+    for(size_t i=0; i<m_phases.size(); i++) {
+	if(t < m_phases[i].start + m_phases[i].duration) {
+	    return t < m_phases[i].start ? m_phases.size() : i;
+	}
+    }
+    return m_phases.size();
+}
+
+std::optional<double> LoadProfile::arrival(double k) const
+{
+    // the number of arrivals during a phase is the integral of the rate:
+    // n(tau) = from * tau + (to - from) * tau^2 / (2 * duration), solved for tau
+    double remaining = k;
+    for(auto &p: m_phases) {
+	double count = (p.from + p.to) / 2 * p.duration;
+	if(remaining < count) {
+	    if(remaining <= 0) {
+		return p.start;
+	    }
+	    double a = (p.to - p.from) / (2 * p.duration);
+	    // a ramp from zero has a > 0 here, since count > remaining > 0: the general form would give 0/0
+	    double tau = p.from == 0 ? std::sqrt(remaining / a)
+		: 2 * remaining / (p.from + std::sqrt(std::max(0.0, p.from * p.from + 4 * a * remaining)));
+	    return p.start + std::min(tau, p.duration);
+	}
+	remaining -= count;
+    }
+    return std::nullopt;
+}
+
+std::optional<double> LoadProfile::activation(size_t th, double t) const
+{
+    // thread #th is active when the level is at least th+1
+    const double n = static_cast<double>(th + 1);
+
+    for(auto &p: m_phases) {
+	double end = p.start + p.duration;
+	double from = std::max(t, p.start);
+	if(from >= end) {
+	    continue;
+	}
+
+	if(p.from >= n && p.to >= n) {
+	    return from;
+	} else if(p.from < n && p.to >= n) {
+	    // ramping up: active once the level crosses n
+	    double crossing = p.start + p.duration * (n - p.from) / (p.to - p.from);
+	    if(crossing < end) {
+		return std::max(from, crossing);
+	    }
+	} else if(p.from >= n && p.to < n) {
+	    // ramping down: active until the level crosses n
+	    double crossing = p.start + p.duration * (p.from - n) / (p.from - p.to);
+	    if(from < crossing) {
+		return from;
+	    }
+	}
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,91 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// loadprofile.hpp: a time-varying load, made of successive phases
+//
+// A profile is a comma-separated list of phases, each given as "level@seconds" (constant load),
+// or "from-to@seconds" (linear ramp). Levels are arrival rates, in Tnx/s (open-loop),
+// or numbers of active threads when suffixed with 't' (closed-loop); all phases must use the same kind.
+// A group of phases can be repeated, as in "[100@9,1000@1]*6".
+//
+// Examples:
+//  - ramp-up:   "1t-16t@60"
+//  - staircase: "100@10,200@10,300@10,400@10"
+//  - bursts:    "[200@9,2000@1]*6,200@30" (including the recovery after the last burst)
+
+#if !defined(LOADPROFILE_H)
+#define LOADPROFILE_H
+
+#include <string>
+#include <vector>
+#include <optional>
+
+class LoadProfile
+{
+public:
+    enum class Unit {
+	rate,			// arrival rate, in Tnx/s
+	threads			// number of active threads
+    };
+
+    struct Phase {
+	double from;		// level at the start of the phase
+	double to;		// level at the end of the phase
+	double start;		// start of the phase, in seconds from the origin
+	double duration;	// duration of the phase, in seconds
+    };
+
+    // constructor: parse the profile. Throws std::invalid_argument when the profile is malformed.
+    LoadProfile(const std::string &profile);
+
+    inline Unit unit() const { return m_unit; }
+    inline const std::vector<Phase> &phases() const { return m_phases; }
+    inline const std::string &name() const { return m_name; }
+
+    // duration(): total duration of the profile, in seconds
+    double duration() const;
+
+    // peak(): highest level reached
+    double peak() const;
+
+    // describe(): human-readable description of a phase
+    std::string describe(size_t phase) const;
+
+    // phase(): index of the phase at a time from the origin, phases().size() past the end
+    size_t phase(double t) const;
+
+    // arrival(): for rate profiles, time from the origin of the k-th arrival (counting from zero),
+    // or std::nullopt when the profile ends before
+    std::optional<double> arrival(double k) const;
+
+    // activation(): for thread profiles, the earliest time at or after t when thread #th is active,
+    // i.e. when the level is above th, or std::nullopt when it is never active again
+    std::optional<double> activation(size_t th, double t) const;
+
+private:
+    // parse(): parse a list of phases, recursively for repeated groups
+    void parse(const std::string &profile, std::vector<Phase> &phases, std::optional<Unit> &unit);
+
+    std::string m_name;
+    Unit m_unit { Unit::rate };
+    std::vector<Phase> m_phases;
+};
+
+
+#endif // LOADPROFILE_H
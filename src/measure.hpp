@@ -38,10 +38,11 @@ public:
 	m_error(err),
 	m_unit(unit),
 	m_error_precision(e_precision),
-	m_value_order(ceil(log10(val))),
+	m_value_order(ceil(log10(std::abs(val)))),
 	m_error_order(err > 0 ? ceil(log10(err)) : 0) {
 
-	auto digits = [](T n) -> int { return ceil(std::abs(log10(n))) * copysign(1,log10(n)); };
+	// measures may be negative (e.g. differences), their order is that of their magnitude
+	auto digits = [](T n) -> int { return ceil(std::abs(log10(std::abs(n)))) * copysign(1,log10(std::abs(n))); };
 
 	if (err > 0) {
 	    m_precision = digits(val) - digits(err) + 1;
@@ -74,7 +75,8 @@ private:
 
     // rounder() is used to chop figures from n, given a wanted precision (p)
     T rounder(T n, T p) const {
-        auto shift = p - ceil(log10(n));
+	if(n == 0) return n;	// nothing to round, and log10() is undefined
+        auto shift = p - ceil(log10(std::abs(n)));
 	return round(n*pow(10,shift)) / pow(10,shift);
     }
 };
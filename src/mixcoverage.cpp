@@ -0,0 +1,65 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// mixcoverage.cpp: a class to handle the composition of a mixed workload
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/tokenizer.hpp>
+#include "mixcoverage.hpp"
+
+MixCoverage::MixCoverage(std::string tocover)
+{
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > toparse(tocover, sep);
+
+    for(auto token : toparse) {
+	auto colon = token.find(':');
+	char *next = nullptr;
+	double weight = 0.0;
+
+	if(colon != std::string::npos) {
+	    weight = std::strtod(token.c_str() + colon + 1, &next);
+	}
+
+	if(colon == std::string::npos || colon == 0 || next == token.c_str() + colon + 1 || *next != '\0' || !(weight > 0)) {
+	    std::cerr << "Invalid mix entry: " << token << ", skipping." << std::endl;
+	    continue;
+	}
+
+	auto testcase = token.substr(0, colon);
+	auto found = std::find_if(m_entries.begin(), m_entries.end(), [&](auto &entry) { return entry.first == testcase; });
+	if(found != m_entries.end()) {
+	    std::cerr << "Test case " << testcase << " specified more than once in mix, skipping." << std::endl;
+	    continue;
+	}
+
+	m_entries.emplace_back(testcase, weight);
+    }
+}
+
+std::string MixCoverage::tests() const
+{
+    std::string rv;
+    for(auto &entry: m_entries) {
+	rv += (rv.empty() ? "" : ",") + entry.first;
+    }
+    return rv;
+}
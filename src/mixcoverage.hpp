@@ -0,0 +1,51 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// mixcoverage.hpp: a class to handle the composition of a mixed workload
+//
+// The mix is made of comma-separated test cases, each followed by its weight, e.g. "aesgcm:60,ecdsa:30,oaepunw:10".
+// Test cases are named as for the test coverage. Weights are relative, and need not add up to 100.
+
+#if !defined(MIXCOVERAGE_H)
+#define MIXCOVERAGE_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+class MixCoverage
+{
+public:
+    MixCoverage(std::string tocover);
+
+    inline bool empty() const noexcept { return m_entries.empty(); }
+    inline std::size_t size() const noexcept { return m_entries.size(); }
+
+    inline auto begin() const noexcept { return m_entries.begin(); }
+    inline auto end() const noexcept { return m_entries.end(); }
+
+    // tests(): test cases of the mix, as a test coverage string
+    std::string tests() const;
+
+private:
+    std::vector<std::pair<std::string, double> > m_entries; // test case, weight
+};
+
+
+#endif // MIXCOVERAGE_H
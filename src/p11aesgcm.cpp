@@ -122,5 +122,6 @@ void P11AESGCMBenchmark::crashtestdummy(Session &session)
     }
 
     session.module()->C_EncryptInit(session.handle(), &m_mech_aes_gcm, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Encrypt( session.handle(), m_payload.data(), m_payload.size(), m_encrypted.data(), &returned_len);
 }
@@ -23,7 +23,7 @@
 #include <sstream>
 #include <mutex>
 #include <thread>
-#include <condition_variable>
+#include <algorithm>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -32,11 +32,6 @@
 #include "p11benchmark.hpp"
 #include "errorcodes.hpp"
 
-// thread sync objects
-extern std::mutex greenlight_mtx;
-extern std::condition_variable greenlight_cond;
-extern bool greenlight;
-
 static std::mutex display_mtx;
 
 
@@ -84,27 +79,74 @@ std::string P11Benchmark::build_threaded_label(std::optional<size_t> threadindex
 void P11Benchmark::reset_timer()
 {
     m_timer = milliseconds_double_t{0};
-    m_last_clock = std::chrono::high_resolution_clock::now();
+    m_phase_timers.fill(milliseconds_double_t{0});
+    m_last_clock = Timer::now();
 }
 
-// suspend_timer(): pause timer accumulation by adding elapsed time since last resume
+// suspend_timer(): pause timer accumulation by adding elapsed time since last resume.
+// The cost of a timer read, included in the interval, is taken off.
 void P11Benchmark::suspend_timer()
 {
-    auto now =  std::chrono::high_resolution_clock::now();
-    m_timer += std::chrono::duration_cast<milliseconds_double_t>(now - m_last_clock);
+    auto now = Timer::now();
+    auto interval = std::chrono::duration_cast<milliseconds_double_t>(std::max(Timer::duration(m_last_clock, now) - Timer::overhead(), nanoseconds_double_t{0}));
+    m_timer += interval;
+    m_phase_timers[static_cast<size_t>(Phase::operation)] += interval;
     m_last_clock = now;		// not really needed
 }
 
 // resume_timer(): resume timer accumulation from current time
 void P11Benchmark::resume_timer()
 {
-    m_last_clock = std::chrono::high_resolution_clock::now();
+    m_last_clock = Timer::now();
+}
+
+// split_timer(): charge the time elapsed since the last reset, resume or split to a phase, and go on timing
+void P11Benchmark::split_timer(Phase phase)
+{
+    if(!m_breakdown) {
+	return;
+    }
+    auto now = Timer::now();
+    auto interval = std::chrono::duration_cast<milliseconds_double_t>(std::max(Timer::duration(m_last_clock, now) - Timer::overhead(), nanoseconds_double_t{0}));
+    m_timer += interval;
+    m_phase_timers[static_cast<size_t>(phase)] += interval;
+    m_last_clock = now;
+}
+
+// find(): find the object to run the benchmark with
+Object P11Benchmark::find(Session &session, std::optional<size_t> threadindex)
+{
+    auto label = build_threaded_label(threadindex); // build threaded label (if needed)
+
+    AttributeContainer search_template;
+    search_template.add_string( AttributeType::Label, label );
+    search_template.add_class( m_objectclass );
+
+    auto found_objs = Object::search<Object>( session, search_template.attributes() );
+
+    if( found_objs.size()==0 ) {
+        throw benchmark_result::NotFound(label);
+    } else if( found_objs.size()>1 ) {
+        throw benchmark_result::AmbiguousResult(label);
+    }
+
+    return found_objs.front();
 }
 
-benchmark_result::benchmark_result_t P11Benchmark::execute(Session *session, const std::vector<uint8_t> &payload, size_t iterations, size_t skipiterations, std::optional<size_t> threadindex)
+benchmark_result::benchmark_result_t P11Benchmark::execute(Session *session, const std::vector<uint8_t> &payload, size_t iterations, size_t skipiterations, std::optional<size_t> threadindex, Barrier &start, const RunOptions &options)
 {
     benchmark_result::operation_outcome_t return_code = benchmark_result::Ok{};
-    std::vector<milliseconds_double_t> records(iterations);
+    benchmark_result::datapoints_t records;
+    bool started = false;	// whether we went through the start barrier
+    std::optional<Datapoint> inflight; // operation being run, streamed with its outcome should it fail (streaming only)
+    std::chrono::steady_clock::time_point inflight_start;
+
+    // stream(): push a datapoint to the sink; when the ring is full, it is dropped rather than waited for
+    auto stream = [&](const Datapoint &datapoint) {
+        if(!options.sink->ring->try_push(datapoint)) {
+            records.dropped++;
+        }
+    };
 
     // a small lambda to handle exceptions in a uniform way
     auto handle_benchmark_exception = [&](auto const& exc) {
@@ -117,53 +159,164 @@ benchmark_result::benchmark_result_t P11Benchmark::execute(Session *session, con
     };
 
     try {
-        auto label = build_threaded_label(threadindex); // build threaded label (if needed)
-
         m_payload = payload;	// remember the payload
+        m_breakdown = options.breakdown;
+
+        auto obj = find(*session, threadindex);
+        const bool mixed = !operations().empty(); // records are tagged with their operation
+
+        prepare(*session, obj, threadindex);
+
+        // check payload size support
+        if( !is_payload_supported( m_payload.size() ) ) {
+            throw benchmark_result::PayloadSizeNotSupported(m_payload.size());
+        }
 
-        AttributeContainer search_template;
-        search_template.add_string( AttributeType::Label, label );
-        search_template.add_class( m_objectclass );
+        // allocate the record buffers ahead, from this thread, so they are local to it
+        if(options.histogram) {
+            records.histogram.emplace(*options.histogram);
+        } else if(!options.window) {
+            records.latency.reserve(iterations);
+            records.timestamp.reserve(iterations);
+            records.completion.reserve(iterations);
+        }
+        if(!options.window) {
+            if(options.pacing) {
+                records.response.reserve(iterations);
+            }
+            if(options.pool) {
+                records.checkout.reserve(iterations);
+            }
+            if(mixed) {
+                records.operation.reserve(iterations);
+            }
+            if(options.breakdown) {
+                records.init.reserve(iterations);
+                records.cleanup.reserve(iterations);
+            }
+        }
 
-        auto found_objs = Object::search<Object>( *session, search_template.attributes() );
+        // wait at the start barrier - all threads are starting together
+        using clock = std::chrono::steady_clock;
+        started = true;
+        const auto origin = start.arrive_and_wait();
 
-        if( found_objs.size()==0 ) {
-            throw benchmark_result::NotFound(label);
-        } else	if( found_objs.size()>1 ) {
-            throw benchmark_result::AmbiguousResult(label);
-        } else {
-            for (auto &obj: found_objs) {
+        // ok go now!
 
-                prepare(*session, obj, threadindex);
+        // in duration-based mode, the run stops at the deadline. Operations started during
+        // the warm-up phase, or completed after the deadline, are not recorded.
+        const auto warmup_end = options.window ? origin + std::chrono::duration_cast<clock::duration>(options.window->warmup) : origin;
+        const auto deadline = options.window ? warmup_end + std::chrono::duration_cast<clock::duration>(options.window->duration) : clock::time_point::max();
 
-                // check payload size support
-                if( !is_payload_supported( m_payload.size() ) ) {
-                    throw benchmark_result::PayloadSizeNotSupported(m_payload.size());
-                }
+        // in open-loop mode, every operation has a slot on the timetable, including skipped ones.
+        // when the thread is late (i.e. the previous operation overran the slot), the operation
+        // is fired immediately, and the response time accounts for the delay.
+        for (size_t i=0; options.window || i<skipiterations+iterations; i++) {
+            auto intended = origin;
+            bool late = false;
 
-                // wait for green light - all threads are starting together
-                {
-                    std::unique_lock<std::mutex> greenlight_lck(greenlight_mtx);
-                    greenlight_cond.wait(greenlight_lck,[]{ return greenlight; });
+            if(options.pacing) {
+                auto due = options.pacing->due(i);
+                if(!due) {
+                    break;	// end of the timetable
                 }
+                intended = origin + std::chrono::duration_cast<clock::duration>(*due);
+                if(intended >= deadline) {
+                    break;
+                }
+                if(clock::now() < intended) {
+                    std::this_thread::sleep_until(intended);
+                } else {
+                    late = true;
+                }
+            } else if(options.activity) {
+                // in closed-loop mode, an inactive thread waits until it is active again
+                auto next = options.activity->next(clock::now() - origin);
+                if(!next) {
+                    break;
+                }
+                auto resume = origin + std::chrono::duration_cast<clock::duration>(*next);
+                if(resume >= deadline) {
+                    break;
+                }
+                if(clock::now() < resume) {
+                    std::this_thread::sleep_until(resume);
+                }
+            }
+
+            auto opstart = clock::now();
+            if(opstart >= deadline) {
+                break;
+            }
+
+            // with a session pool, the operation runs on whichever session is free.
+            // The wait for it is timed apart, and is not part of the latency.
+            // The session returns to the pool once the lease is released, even when an operation fails.
+            std::optional<SessionPool::Lease> lease;
+            Session *opsession = session;
+            auto checkedout = opstart;
+            if(options.pool) {
+                lease.emplace(*options.pool);
+                checkedout = clock::now();
+                opsession = &lease->session();
+                rebind(*opsession, obj);
+            }
+
+            if(options.sink) {
+                inflight = Datapoint { std::chrono::duration_cast<milliseconds_double_t>(opstart - origin).count(), 0.0, opsession->handle(), options.sink->thread, 0 };
+                inflight_start = opstart;
+            }
+
+            reset_timer();
+            crashtestdummy(*opsession);
+            suspend_timer();
+            auto completed = clock::now();
+            if(options.breakdown) {
+                // cleanup is timed apart, as it is not part of the latency
+                auto cleanup_start = Timer::now();
+                cleanup(*opsession);
+                auto cleanup_end = Timer::now();
+                m_phase_timers[static_cast<size_t>(Phase::cleanup)] = std::chrono::duration_cast<milliseconds_double_t>(std::max(Timer::duration(cleanup_start, cleanup_end) - Timer::overhead(), nanoseconds_double_t{0}));
+            } else {
+                cleanup(*opsession); // cleanup any created object (e.g. unwrapped or derived keys)
+            }
 
-                // ok go now!
+            lease.reset();
 
-                // first run iterations that are skipped, i.e. not taken into account for stats
-                for (size_t i=0; i<skipiterations; i++) {
-                    crashtestdummy(*session);
-                    cleanup(*session); // cleanup any created object (e.g. unwrapped or derived keys)
+            bool recorded = options.window ? (opstart >= warmup_end && completed <= deadline) : (i >= skipiterations);
+            if(options.sink && recorded) {
+                inflight->latency = elapsed().count();
+                stream(*inflight);
+            }
+            inflight.reset();
+
+            if(recorded) {
+                if(records.histogram) {
+                    records.histogram->record(elapsed());
+                } else {
+                    records.latency.push_back(elapsed());
+                    records.timestamp.push_back(std::chrono::duration_cast<milliseconds_double_t>(opstart - origin));
+                    records.completion.push_back(std::chrono::duration_cast<milliseconds_double_t>(completed - origin));
+                }
+                if(mixed) {
+                    records.operation.push_back(operation());
+                }
+                if(options.breakdown) {
+                    records.init.push_back(elapsed(Phase::init));
+                    records.cleanup.push_back(elapsed(Phase::cleanup));
                 }
-                for (size_t i=0; i<iterations; i++) {
-                    reset_timer();
-                    crashtestdummy(*session);
-                    suspend_timer();
-                    cleanup(*session); // cleanup any created object (e.g. unwrapped or derived keys)
-                    records.at(i) = elapsed();
+                if(options.pool) {
+                    records.checkout.push_back(std::chrono::duration_cast<milliseconds_double_t>(checkedout - opstart));
+                }
+                if(options.pacing) {
+                    records.response.push_back(std::chrono::duration_cast<milliseconds_double_t>(completed - intended));
+                    if(late) {
+                        records.missed++;
+                    }
                 }
-                teardown(*session, obj, threadindex); // perform any needed teardown
             }
         }
+        teardown(*session, obj, threadindex); // perform any needed teardown
     } catch (benchmark_result::PayloadSizeNotSupported &psns) {
         handle_benchmark_exception(psns);
     } catch (benchmark_result::NotFound &nfe) {
@@ -177,12 +330,29 @@ benchmark_result::benchmark_result_t P11Benchmark::execute(Session *session, con
                 << " (" << errorcode(bexc.error_code()) << ")" 
                 << std::endl;
         return_code = benchmark_result::ApiErr{bexc.error_code()};
+        if(inflight) {
+            inflight->latency = std::chrono::duration_cast<milliseconds_double_t>(std::chrono::steady_clock::now() - inflight_start).count();
+            inflight->outcome = static_cast<uint32_t>(bexc.error_code());
+            stream(*inflight);
+        }
     } catch (...) {	
-        std::lock_guard<std::mutex> lg{display_mtx};
-        std::cerr << "ERROR: caught an unmanaged exception" << std::endl;
+        {
+            std::lock_guard<std::mutex> lg{display_mtx};
+            std::cerr << "ERROR: caught an unmanaged exception" << std::endl;
+        }
+        // the other threads are waiting for us at the start barrier
+        if(!started) {
+            start.arrive_and_wait();
+        }
         // rethrow
         throw;
     }
 
+    // when we failed before reaching the start barrier, we must still show up,
+    // so the other threads are not blocked forever
+    if(!started) {
+        start.arrive_and_wait();
+    }
+
     return std::make_pair( std::move(records), return_code );
 }
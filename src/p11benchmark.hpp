@@ -25,6 +25,8 @@
 #include <chrono>
 #include <variant>
 #include <exception>
+#include <functional>
+#include <array>
 #include <botan/auto_rng.h>
 #include <botan/p11_types.h>
 #include <botan/p11_object.h>
@@ -32,6 +34,12 @@
 #include <botan/p11_ecdsa.h>
 #include <botan/pubkey.h>
 #include "units.hpp"
+#include "recordbuffer.hpp"
+#include "histogram.hpp"
+#include "timer.hpp"
+#include "datapointwriter.hpp"
+#include "barrier.hpp"
+#include "sessionpool.hpp"
 #include "implementation.hpp"
 #include "../config.h"
 
@@ -44,22 +52,25 @@ namespace benchmark_result {
     // an exception to signal that an object was not found
     class NotFound : public std::exception
     {
+        std::string m_label;
         mutable std::string m_whatmsg;
 
     public:
         // constructor - with a label
-        NotFound(const std::string &label) {
+        NotFound(const std::string &label) : m_label(label) {
             m_whatmsg = "Object with label '" + label + "' not found";
         }
 
         // constructor - with a C string label
-        NotFound(const char *label) {
+        NotFound(const char *label) : m_label(label) {
             m_whatmsg = "Object with label '" + std::string(label) + "' not found";
         }
 
         // copy constructor
         NotFound(const NotFound&) = default;
 
+        inline const std::string &label() const { return m_label; }
+
         virtual const char* what() const noexcept override
         {
             return m_whatmsg.c_str();
@@ -69,21 +80,24 @@ namespace benchmark_result {
     // an exception to signal that multiple objects were found when only one was expected
     class AmbiguousResult : public std::exception
     {
+        std::string m_label;
         mutable std::string m_whatmsg;
 
     public:
         // constructor - with a label
-        AmbiguousResult(const std::string &label) {
+        AmbiguousResult(const std::string &label) : m_label(label) {
             m_whatmsg = "Multiple objects with label '" + label + "' found";
         }
 
         // constructor - with a C string label
-        AmbiguousResult(const char *label) {
+        AmbiguousResult(const char *label) : m_label(label) {
             m_whatmsg = "Multiple objects with label '" + std::string(label) + "' found";
         }
         
         // copy constructor
         AmbiguousResult(const AmbiguousResult&) = default;
+
+        inline const std::string &label() const { return m_label; }
         virtual const char* what() const noexcept override
         {
             return m_whatmsg.c_str();
@@ -105,6 +119,8 @@ namespace benchmark_result {
         // copy constructor
         PayloadSizeNotSupported(const PayloadSizeNotSupported&) = default;
 
+        inline size_t size() const { return m_size; }
+
         virtual const char* what() const noexcept override
         {
             return m_whatmsg.c_str();
@@ -117,24 +133,91 @@ namespace benchmark_result {
     using ApiErr = decltype(std::declval<Botan::PKCS11::PKCS11_ReturnError>().error_code());
 
     using operation_outcome_t = std::variant<Ok, ApiErr, NotFound, AmbiguousResult, PayloadSizeNotSupported>;
-    using benchmark_result_t = std::pair<std::vector<milliseconds_double_t>,operation_outcome_t>;
+
+    // datapoints collected by one thread
+    struct datapoints_t {
+        RecordBuffer<milliseconds_double_t> latency;  // service time, i.e. time spent inside the measured calls
+        RecordBuffer<milliseconds_double_t> response; // response time, measured from the intended start (open-loop only)
+        size_t missed {0};                           // number of slots where the thread was still busy (open-loop only)
+        RecordBuffer<milliseconds_double_t> checkout; // time spent waiting for a session (session pool only)
+        RecordBuffer<uint32_t> operation;            // operation of each latency record (mixed workloads only)
+        RecordBuffer<milliseconds_double_t> timestamp; // start of each recorded operation, measured from the origin
+        RecordBuffer<milliseconds_double_t> completion; // end of each recorded operation, before cleanup, on the same clock as timestamp
+        std::optional<Histogram> histogram;           // latencies, counted instead of recorded in latency and timestamp (histogram mode only)
+        size_t dropped {0};                          // number of datapoints not streamed, the ring being full (streaming only)
+        RecordBuffer<milliseconds_double_t> init;     // part of each latency record spent in init calls (phase breakdown only)
+        RecordBuffer<milliseconds_double_t> cleanup;  // time spent in cleanup after each recorded operation, not part of the latency (phase breakdown only)
+    };
+
+    using benchmark_result_t = std::pair<datapoints_t,operation_outcome_t>;
 }
 
+// pacing, for open-loop execution
+// each thread is given a timetable: due(k) is the intended start of the operation #k, measured from the origin,
+// or std::nullopt when the timetable ends.
+struct Pacing {
+    std::function<std::optional<nanoseconds_double_t>(size_t)> due;
+};
+
+// activity, for closed-loop load profiles
+// a thread runs operations only while it is active: next(t) is the earliest time at or after t,
+// measured from the origin, when the thread is active, or std::nullopt when it will not be active again.
+struct Activity {
+    std::function<std::optional<nanoseconds_double_t>(nanoseconds_double_t)> next;
+};
+
+// time window, for duration-based execution
+// operations are executed until origin + warmup + duration is reached;
+// only these started after the warm-up and completed before the deadline are recorded
+struct TimeWindow {
+    nanoseconds_double_t warmup;   // duration of the warm-up phase, not recorded
+    nanoseconds_double_t duration; // duration of the measurement window
+};
+
+// run options of a thread, for P11Benchmark::execute(). The defaults make a closed-loop run
+// of a fixed number of iterations, on the session of the thread, with latencies recorded one by one.
+struct RunOptions {
+    std::optional<Pacing> pacing;	// timetable, for open-loop execution
+    std::optional<TimeWindow> window;	// time window, for duration-based execution
+    SessionPool *pool {nullptr};	// session pool operations run on, if any
+    std::optional<Activity> activity;	// activity, for closed-loop load profiles
+    std::optional<int> histogram;	// significant digits of the latency histogram, in histogram mode
+    std::optional<DatapointSink> sink;	// datapoint stream, if any
+    bool breakdown {false};		// time spent in init calls and in cleanup is recorded apart
+};
+
 class P11Benchmark
 {
+public:
+    // phases of an operation, timed apart with phase breakdown: init calls (e.g. C_EncryptInit), the operation itself,
+    // and the cleanup that follows, which is not part of the latency
+    enum class Phase : size_t {
+	init,
+	operation,
+	cleanup
+    };
+
+private:
     std::string m_name;
     std::string m_label;
     ObjectClass m_objectclass;
     Implementation m_implementation;
     milliseconds_double_t m_timer {0};
-    std::chrono::high_resolution_clock::time_point m_last_clock {};
+    Timer::ticks_t m_last_clock {0};
+    std::array<milliseconds_double_t, 3> m_phase_timers {}; // time spent in each phase, for the last call of crashtestdummy() (and cleanup())
+    bool m_breakdown {false};	// whether phases are timed apart
 
-    inline milliseconds_double_t elapsed() const { return m_timer; };
     void reset_timer();
 
+    // a mixed workload drives the benchmarks it is made of
+    friend class P11MixBenchmark;
+
 protected:
     std::vector<uint8_t> m_payload;
 
+    // find(): find the object to run the benchmark with, from its label and object class
+    virtual Object find(Session &session, std::optional<size_t> threadindex);
+
     // prepare(): prepare calls to crashtestdummy() with object found
     virtual void prepare(Session &session, Object &obj, std::optional<size_t> threadindex)=0;
 
@@ -144,9 +227,22 @@ protected:
     // cleanup(): perform cleanup after each call of crashtestdummy(), if needed
     virtual void cleanup(Session &session) { };
 
+    // rebind(): with a session pool, called before crashtestdummy() with the session checked out for it.
+    // Benchmarks holding state bound to a session (e.g. Botan key objects) must switch to that session.
+    virtual void rebind(Session &session, Object &obj) { };
+
     // teardown(): perform teardown after all iterations are done, if needed
     virtual void teardown(Session &session, Object &obj, std::optional<size_t> threadindex) { };
 
+    // elapsed(): time measured for the last call of crashtestdummy()
+    virtual milliseconds_double_t elapsed() const { return m_timer; };
+
+    // elapsed(): with phase breakdown, time spent in a phase for the last call of crashtestdummy() and cleanup()
+    virtual milliseconds_double_t elapsed(Phase phase) const { return m_phase_timers[static_cast<size_t>(phase)]; };
+
+    // operation(): for mixed workloads, index of the operation run by the last call of crashtestdummy()
+    virtual size_t operation() const { return 0; };
+
     // rename(): change the name of the class after creation
     inline void rename(std::string newname) { m_name = newname; };
 
@@ -161,6 +257,9 @@ protected:
     void suspend_timer();
     // resume_timer(): resume timer accumulation
     void resume_timer();
+    // split_timer(): with phase breakdown, charge the time elapsed since the timer was reset, resumed or last split
+    // to phase, instead of the operation. Without phase breakdown, it does nothing (and does not read the timer).
+    void split_timer(Phase phase);
 
 public:
     P11Benchmark(const std::string &name,
@@ -182,10 +281,22 @@ public:
 
     virtual std::string features() const;
 
+    // operations(): for mixed workloads, names of the operations the benchmark is made of
+    virtual std::vector<std::string> operations() const { return {}; }
+
     // provides a way to test cases to skip invalid key sizes
     virtual bool is_payload_supported(size_t payload_size) { return true; }
 
-    benchmark_result::benchmark_result_t execute(Session* session, const std::vector<uint8_t> &payload, size_t iterations, size_t skipiterations, std::optional<size_t> threadindex);
+    // execute(): prepare, wait for all threads to reach the start barrier, then run the measured loop.
+    // The release time of the barrier is the origin for pacing and time window.
+    // When a session pool is given, each operation runs on a session checked out from the pool,
+    // and session is only used to find the object, prepare and tear down.
+    // With an activity, the thread stays idle while it is not active.
+    // When a number of significant digits is given for histogram, latencies are counted in a histogram of that precision,
+    // instead of being recorded one by one: memory then remains bounded, whatever the length of the run.
+    // With a sink, recorded operations (and the one that fails, if any) are also pushed to a datapoint stream; this never blocks.
+    // With breakdown, the time spent in init calls and in cleanup is also recorded for each operation.
+    benchmark_result::benchmark_result_t execute(Session* session, const std::vector<uint8_t> &payload, size_t iterations, size_t skipiterations, std::optional<size_t> threadindex, Barrier &start, const RunOptions &options);
 
 };
 
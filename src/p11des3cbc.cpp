@@ -47,5 +47,6 @@ void P11DES3CBCBenchmark::crashtestdummy(Session &session)
 {
     Ulong returned_len=m_encrypted.size();
     session.module()->C_EncryptInit(session.handle(), &m_mech_des3cbc, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Encrypt( session.handle(), m_payload.data(), m_payload.size(), m_encrypted.data(), &returned_len);
 }
@@ -29,7 +29,6 @@ P11ECDSASigBenchmark::P11ECDSASigBenchmark(const P11ECDSASigBenchmark & other) :
     // we don't want to copy specific members,
     // the only we need to matter for m_rng
 
-    m_ecdsakey = nullptr;
     m_signer = nullptr;
     m_rng.force_reseed();
 }
@@ -41,11 +40,8 @@ inline P11ECDSASigBenchmark *P11ECDSASigBenchmark::clone() const {
 
 void P11ECDSASigBenchmark::prepare(Session &session, Object &obj, std::optional<size_t> threadindex)
 {
-    m_ecdsakey = std::unique_ptr<PKCS11_ECDSA_PrivateKey>(new PKCS11_ECDSA_PrivateKey(session, obj.handle()));
-    m_signer = std::unique_ptr<Botan::PK_Signer>(new Botan::PK_Signer( *m_ecdsakey,
-								       m_rng,
-								       "Raw",
-								       Botan::Signature_Format::IEEE_1363 ));
+    m_signers.clear();
+    m_signer = signer(session, obj.handle());
 
     // PKCS#11 ECDSA does not hash (except CKM_ECDSA_SHA1, which we don't test
     // as such, software hashing must take place. We use a Botan::HashFunction to do that job.
@@ -56,6 +52,26 @@ void P11ECDSASigBenchmark::prepare(Session &session, Object &obj, std::optional<
     m_digest = sha256->final() ;
 }
 
+void P11ECDSASigBenchmark::rebind(Session &session, Object &obj)
+{
+    m_signer = signer(session, obj.handle());
+}
+
+Botan::PK_Signer *P11ECDSASigBenchmark::signer(Session &session, ObjectHandle handle)
+{
+    auto &entry = m_signers[session.handle()];
+
+    if(!entry.second) {
+	entry.first = std::unique_ptr<PKCS11_ECDSA_PrivateKey>(new PKCS11_ECDSA_PrivateKey(session, handle));
+	entry.second = std::unique_ptr<Botan::PK_Signer>(new Botan::PK_Signer( *entry.first,
+									      m_rng,
+									      "Raw",
+									      Botan::Signature_Format::IEEE_1363 ));
+    }
+
+    return entry.second.get();
+}
+
 void P11ECDSASigBenchmark::crashtestdummy(Session &session)
 {
     auto signature = m_signer->sign_message( m_digest, m_rng );
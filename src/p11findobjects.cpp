@@ -147,6 +147,7 @@ void P11FindObjectsBenchmark::crashtestdummy(Session &session)
         m_search_template.data(),
         static_cast<Ulong>(m_search_template.count())
     );
+    split_timer(Phase::init);
     
     // C_FindObjects - search for the target object
     ObjectHandle found_object;
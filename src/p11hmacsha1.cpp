@@ -41,5 +41,6 @@ void P11HMACSHA1Benchmark::crashtestdummy(Session &session)
 {
     Ulong returned_len=m_digest.size();
     session.module()->C_SignInit(session.handle(), &m_mech_hmac_sha1, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Sign( session.handle(), m_payload.data(), m_payload.size(), m_digest.data(), &returned_len);
 }
@@ -42,5 +42,6 @@ void P11HMACSHA512Benchmark::crashtestdummy(Session &session)
 {
     Ulong returned_len=m_digest.size();
     session.module()->C_SignInit(session.handle(), &m_mech_hmac_sha512, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Sign( session.handle(), m_payload.data(), m_payload.size(), m_digest.data(), &returned_len);
 }
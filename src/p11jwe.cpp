@@ -298,6 +298,7 @@ void P11JWEBenchmark::crashtestdummy(Session &session)
 
     resume_timer();
     session.module()->C_DecryptInit(session.handle(), &m_mech_aes_gcm, symkey_handle);
+    split_timer(Phase::init);
     session.module()->C_Decrypt(session.handle(), m_encrypted.data(), m_encrypted.size(), m_decrypted.data(), &returned_len);
     suspend_timer();
 
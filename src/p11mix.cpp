@@ -0,0 +1,130 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "p11mix.hpp"
+
+
+P11MixBenchmark::P11MixBenchmark(const std::string &name, const std::string &label, std::vector<std::pair<std::unique_ptr<P11Benchmark>, double> > mix) :
+    // the object class is not used: each test case of the mix finds its own object
+    P11Benchmark( name, label, ObjectClass::SecretKey ),
+    m_rng(std::random_device{}())
+{
+    std::vector<double> weights;
+    for(auto &entry: mix) {
+	m_benchmarks.push_back(std::move(entry.first));
+	weights.push_back(entry.second);
+    }
+    m_draw = std::discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+
+P11MixBenchmark::P11MixBenchmark(const P11MixBenchmark & other) :
+    P11Benchmark(other),
+    m_rng(std::random_device{}()), // each clone draws its own sequence
+    m_draw(other.m_draw)
+{
+    for(auto &benchmark: other.m_benchmarks) {
+	m_benchmarks.emplace_back(benchmark->clone());
+    }
+}
+
+
+inline P11MixBenchmark *P11MixBenchmark::clone() const {
+    return new P11MixBenchmark{*this};
+}
+
+std::vector<std::string> P11MixBenchmark::operations() const
+{
+    std::vector<std::string> rv;
+    for(auto &benchmark: m_benchmarks) {
+	rv.push_back(benchmark->name() + " using " + benchmark->label());
+    }
+    return rv;
+}
+
+bool P11MixBenchmark::is_payload_supported(size_t payload_size)
+{
+    for(auto &benchmark: m_benchmarks) {
+	if(!benchmark->is_payload_supported(payload_size)) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+Object P11MixBenchmark::find(Session &session, std::optional<size_t> threadindex)
+{
+    m_objects.clear();
+    for(auto &benchmark: m_benchmarks) {
+	m_objects.push_back(benchmark->find(session, threadindex));
+    }
+    return m_objects.front();
+}
+
+void P11MixBenchmark::prepare(Session &session, Object &obj, std::optional<size_t> threadindex)
+{
+    for(size_t i=0; i<m_benchmarks.size(); i++) {
+	m_benchmarks[i]->m_payload = m_payload;
+	m_benchmarks[i]->m_breakdown = m_breakdown;
+	m_benchmarks[i]->prepare(session, m_objects[i], threadindex);
+    }
+    m_next = m_draw(m_rng);
+}
+
+void P11MixBenchmark::rebind(Session &session, Object &obj)
+{
+    m_benchmarks[m_next]->rebind(session, m_objects[m_next]);
+}
+
+void P11MixBenchmark::crashtestdummy(Session &session)
+{
+    m_current = m_next;
+    auto &benchmark = *m_benchmarks[m_current];
+
+    // the test case times itself, so the draw and the dispatch are not measured
+    benchmark.reset_timer();
+    benchmark.crashtestdummy(session);
+    benchmark.suspend_timer();
+
+    // the next draw also takes place out of the timers, before the cleanup phase is timed
+    m_next = m_draw(m_rng);
+}
+
+milliseconds_double_t P11MixBenchmark::elapsed() const
+{
+    return m_benchmarks[m_current]->elapsed();
+}
+
+milliseconds_double_t P11MixBenchmark::elapsed(Phase phase) const
+{
+    // cleanup is timed around the mix itself
+    return phase == Phase::cleanup ? P11Benchmark::elapsed(phase) : m_benchmarks[m_current]->elapsed(phase);
+}
+
+void P11MixBenchmark::cleanup(Session &session)
+{
+    m_benchmarks[m_current]->cleanup(session);
+}
+
+void P11MixBenchmark::teardown(Session &session, Object &obj, std::optional<size_t> threadindex)
+{
+    for(size_t i=0; i<m_benchmarks.size(); i++) {
+	m_benchmarks[i]->teardown(session, m_objects[i], threadindex);
+    }
+}
@@ -0,0 +1,89 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#if !defined P11MIX_HPP
+#define P11MIX_HPP
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include "p11benchmark.hpp"
+
+// ============================================================================
+// TEST CASE: Mixed workload
+// ============================================================================
+//
+// DESCRIPTION:
+//   This test case runs several test cases together, to reproduce real
+//   traffic, where different mechanisms are mixed. Before each operation, the
+//   thread draws the test case to run next, according to the weights of the
+//   mix. It exposes interference between mechanisms inside the token, that
+//   runs of a single mechanism hide.
+//
+// PAYLOAD:
+//   The payload is handed over to every test case of the mix. It must be
+//   supported by all of them.
+//
+// KEY REQUIREMENTS:
+//   The keys of every test case of the mix (see each test case).
+//
+// OPTIONS:
+//   --mix <testcase:weight,...> : test cases of the mix, with their weights
+//
+// TESTING APPROACH:
+//   Each test case of the mix is prepared with its own key, before the start
+//   barrier. The draw takes place between operations, and is not measured.
+//   Latency is recorded together with the operation it belongs to, so that
+//   statistics are given for each operation, in addition to these of the mix.
+//
+// ============================================================================
+
+class P11MixBenchmark : public P11Benchmark
+{
+    std::vector<std::unique_ptr<P11Benchmark> > m_benchmarks; // test cases of the mix
+    std::vector<Object> m_objects; // object of each test case
+    std::mt19937_64 m_rng;
+    std::discrete_distribution<size_t> m_draw; // draws test cases according to their weights
+    size_t m_current {0};	// test case run by the last operation
+    size_t m_next {0};		// test case to run by the next operation
+
+    virtual Object find(Session &session, std::optional<size_t> threadindex) override;
+    virtual void prepare(Session &session, Object &obj, std::optional<size_t> threadindex) override;
+    virtual void rebind(Session &session, Object &obj) override;
+    virtual void crashtestdummy(Session &session) override;
+    virtual void cleanup(Session &session) override;
+    virtual void teardown(Session &session, Object &obj, std::optional<size_t> threadindex) override;
+    virtual milliseconds_double_t elapsed() const override;
+    virtual milliseconds_double_t elapsed(Phase phase) const override;
+    virtual size_t operation() const override { return m_current; }
+    virtual P11MixBenchmark *clone() const override;
+
+public:
+
+    // the mix takes ownership of the benchmarks it is made of
+    P11MixBenchmark(const std::string &name, const std::string &label, std::vector<std::pair<std::unique_ptr<P11Benchmark>, double> > mix);
+    P11MixBenchmark(const P11MixBenchmark & other);
+
+    virtual std::vector<std::string> operations() const override;
+    virtual bool is_payload_supported(size_t payload_size) override;
+};
+
+#endif // P11MIX_HPP
@@ -0,0 +1,81 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// p11null: trivial PKCS#11 calls, to measure the overhead of the library (and of the network, for network HSMs)
+
+#include <string>
+#include "p11null.hpp"
+
+
+P11NullBenchmark::P11NullBenchmark(const std::string &label, const Call call) :
+    P11Benchmark( "Null operation", label, ObjectClass::SecretKey ),
+    m_call(call)
+{
+
+    using namespace std::literals;
+
+    switch(m_call) {
+    case Call::GetSessionInfo:
+	rename("Null operation (C_GetSessionInfo())"s);
+	break;
+
+    case Call::GetFunctionStatus:
+	rename("Null operation (C_GetFunctionStatus())"s);
+	break;
+
+    case Call::GetAttributeValue:
+	rename("Null operation (C_GetAttributeValue(CKA_CLASS))"s);
+	break;
+    }
+}
+
+
+P11NullBenchmark::P11NullBenchmark(const P11NullBenchmark &other) :
+    P11Benchmark(other), m_call(other.m_call) { }
+
+
+inline P11NullBenchmark *P11NullBenchmark::clone() const {
+    return new P11NullBenchmark{*this};
+}
+
+void P11NullBenchmark::prepare(Session &session, Object &obj, std::optional<size_t> threadindex)
+{
+    m_objhandle = obj.handle();
+}
+
+void P11NullBenchmark::crashtestdummy(Session &session)
+{
+    switch(m_call) {
+    case Call::GetSessionInfo:
+	session.module()->C_GetSessionInfo( session.handle(), &m_info );
+	break;
+
+    case Call::GetFunctionStatus: {
+	// legacy function: CKR_FUNCTION_NOT_PARALLEL is expected, and must not be thrown
+	ReturnValue rv;
+	session.module()->C_GetFunctionStatus( session.handle(), &rv );
+	break;
+    }
+
+    case Call::GetAttributeValue: {
+	Attribute attribute { CKA_CLASS, &m_class, sizeof m_class };
+	session.module()->C_GetAttributeValue( session.handle(), m_objhandle, &attribute, 1 );
+	break;
+    }
+    }
+}
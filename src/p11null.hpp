@@ -0,0 +1,84 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// p11null: trivial PKCS#11 calls, to measure the overhead of the library (and of the network, for network HSMs)
+
+// ============================================================================
+// TEST CASE: Null Operations (C_GetSessionInfo, C_GetFunctionStatus, C_GetAttributeValue)
+// ============================================================================
+//
+// DESCRIPTION:
+//   This test case measures the latency of PKCS#11 calls that do no
+//   cryptographic work: C_GetSessionInfo, C_GetFunctionStatus, or
+//   C_GetAttributeValue on the CKA_CLASS attribute of a key. Their latency
+//   is the cost of a round trip through the library: dispatch, locking and,
+//   for network HSMs, the hop to the server. It serves as a baseline, to tell
+//   apart the overhead from the cryptographic operation in other test cases.
+//
+// PAYLOAD:
+//   The payload is ignored.
+//
+// KEY REQUIREMENTS:
+//   - Key type: CKK_AES, of any size
+//   - Only C_GetAttributeValue uses the key, to read its CKA_CLASS attribute
+//
+// OPTIONS:
+//   --baseline <testcase> : run that null operation first, and take its
+//                           average latency off the other test cases
+//
+// TESTING APPROACH:
+//   The benchmark loop (crashtestdummy) issues a single call, through the
+//   same execution loop as other test cases. C_GetFunctionStatus is a legacy
+//   function, expected to return CKR_FUNCTION_NOT_PARALLEL: its return value
+//   is ignored. C_GetAttributeValue is issued with a template of a single
+//   attribute, the value buffer being provided, so that it takes one call.
+//
+// ============================================================================
+
+#if !defined P11NULL_HPP
+#define P11NULL_HPP
+
+#include "p11benchmark.hpp"
+
+class P11NullBenchmark : public P11Benchmark
+{
+public:
+    enum class Call : size_t {
+	GetSessionInfo,
+	GetFunctionStatus,
+	GetAttributeValue
+    };
+
+private:
+    Call m_call;		// PKCS#11 call to measure
+    ObjectHandle m_objhandle;	// handle to the key, for C_GetAttributeValue
+    SessionInfo m_info;		// buffer for C_GetSessionInfo
+    CK_OBJECT_CLASS m_class;	// buffer for C_GetAttributeValue
+
+    virtual void prepare(Session &session, Object &obj, std::optional<size_t> threadindex) override;
+    virtual void crashtestdummy(Session &session) override;
+    virtual P11NullBenchmark *clone() const override;
+
+public:
+
+    P11NullBenchmark(const std::string &name, const Call call = Call::GetSessionInfo);
+    P11NullBenchmark(const P11NullBenchmark & other);
+
+};
+
+#endif // P11NULL_HPP
@@ -147,6 +147,7 @@ void P11OAEPDecryptBenchmark::crashtestdummy(Session &session)
     Ulong returned_len=m_decrypted.size();
 
     session.module()->C_DecryptInit(session.handle(), &m_mech_rsa_pkcs_oaep, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Decrypt(session.handle(), m_encrypted.data(), m_encrypted.size(), m_decrypted.data(), &returned_len);
     m_decrypted.resize(returned_len);
 }
@@ -113,6 +113,7 @@ void P11OAEPEncryptBenchmark::crashtestdummy(Session &session)
     Ulong encrypted_size = m_encrypted.size();
 
     session.module()->C_EncryptInit( session.handle(), &m_mech_rsa_pkcs_oaep, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Encrypt( session.handle(), m_payload.data(), m_payload.size(), m_encrypted.data(), &encrypted_size);
     m_encrypted.resize(encrypted_size); // resize object accordingly (truncate if needed)
 
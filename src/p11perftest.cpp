@@ -26,9 +26,13 @@
 #include <string_view>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <forward_list>
 #include <thread>
 #include <cstdlib>
+#include <cstdio>
+#include <optional>
+#include <algorithm>
 #include <sysexits.h>		// BSD exit codes
 
 #include <boost/exception/diagnostic_information.hpp>
@@ -49,7 +53,17 @@
 #include "testcoverage.hpp"
 #include "vectorcoverage.hpp"
 #include "keysizecoverage.hpp"
+#include "threadcoverage.hpp"
+#include "slotcoverage.hpp"
+#include "mixcoverage.hpp"
+#include "groupcoverage.hpp"
+#include "processgroup.hpp"
+#include "sessionpool.hpp"
+#include "cpuaffinity.hpp"
+#include "loadprofile.hpp"
+#include "datapointwriter.hpp"
 #include "timeprecision.hpp"
+#include "timer.hpp"
 #include "keygenerator.hpp"
 #include "executor.hpp"
 #include "p11rsasig.hpp"
@@ -64,6 +78,8 @@
 #include "p11genrandom.hpp"
 #include "p11seedrandom.hpp"
 #include "p11findobjects.hpp"
+#include "p11null.hpp"
+#include "p11mix.hpp"
 #include "p11hmacsha1.hpp"
 #include "p11hmacsha256.hpp"
 #include "p11hmacsha512.hpp"
@@ -102,9 +118,16 @@ int main(int argc, char **argv)
 
     int rv = EXIT_SUCCESS;
     pt::ptree results;
-    int argslot = -1;
     int argiter, argskipiter;
-    int argnthreads;
+    double argrate = 0.0;
+    int argnprocesses;
+    int argsessions;
+    int argmaxiter = 0;
+    int argqueuedepth;
+    double argduration = 0.0, argwarmup = 0.0;
+    double arginterval = 0.0;
+    int arghistogram = 0;
+    int argresamples;
     bool json = false;
     bool datapoints = false;
     std::fstream jsonout;
@@ -118,6 +141,7 @@ int main(int argc, char **argv)
     const auto default_keysizes{"rsa2048,rsa3072,rsa4096,ecnistp256,ecnistp384,ecnistp521,hmac160,hmac256,hmac512,des128,des192,aes128,aes192,aes256"};
     const auto default_flavour{"generic"};
     const auto help_text_flavour = "PKCS#11 implementation flavour. Possible values: " + Implementation::choices();
+    const auto help_text_affinity = "placement of benchmark threads on CPUs. Possible values: " + CpuAffinity::choices();
 
     const auto hwthreads = std::thread::hardware_concurrency(); // how many threads do we have on this platform ?
 
@@ -127,20 +151,78 @@ int main(int argc, char **argv)
 	("library,l", po::value< std::string >(),
 	 "PKCS#11 library path\n"
 	 "overrides PKCS11LIB environment variable")
-	("slot,s", po::value<int>(&argslot),
+	("slot,s", po::value< std::string >(),
 	 "slot index to use\n"
+	 "a list of slot indices, with optional weights (e.g. 0:3,1:1), spreads threads across slots\n"
 	 "overrides PKCS11SLOT environment variable")
 	("password,p", po::value< std::string >(),
 	 "password for token in slot\n"
 	 "overrides PKCS11PASSWORD environment variable")
-	("threads,t", po::value<int>(&argnthreads)->default_value(1), "number of concurrent threads")
+	("threads,t", po::value< std::string >()->default_value("1"),
+	 "number of concurrent threads\n"
+	 "a list of values runs each test case with each number of threads, and fits a scalability model\n"
+	 "e.g. 1,2,4 or 1-16:2 (step) or 1-64*2 (factor)")
+	("processes", po::value<int>(&argnprocesses)->default_value(1),
+	 "number of worker processes, each running the specified number of threads\n"
+	 "with its own instance of the PKCS#11 library")
+	("sessions", po::value<int>(&argsessions)->default_value(0),
+	 "number of sessions per slot, shared among the threads of the slot\n"
+	 "each operation checks out a free session; the wait is measured apart from the latency\n"
+	 "0 gives each thread its own session")
+	("queue-depth", po::value<int>(&argqueuedepth)->default_value(1),
+	 "number of operations in flight per thread, each on its own session\n"
+	 "PKCS#11 calls are blocking: each operation in flight is run by a lane, bound to the CPU and slot of its thread")
 	("iterations,i", po::value<int>(&argiter)->default_value(200), "number of iterations")
-	("skip", po::value<int>(&argskipiter)->default_value(0),
+	("target-relerr", po::value< std::string >(),
+	 "adaptive mode: run iterations in batches of -i, until the relative error on the average latency\n"
+	 "is within the target, e.g. 0.5% or 0.005")
+	("target-p99", "with --target-relerr, the 95% confidence interval of the 99th percentile must also be within the target")
+	("max-iterations", po::value<int>(&argmaxiter),
+	 "with --target-relerr, maximum number of iterations per thread (default: 20 batches)")
+	("duration", po::value<double>(&argduration),
+	 "duration of each test case, in seconds\n"
+	 "when specified, threads run until the deadline, and iterations are ignored")
+	("warmup", po::value<double>(&argwarmup)->default_value(0),
+	 "warm-up duration before recording for statistics, in seconds\n"
+	 "(in addition to duration, requires --duration)")
+	("skip", po::value< std::string >()->default_value("0"),
 	 "number of iterations to skip before recording for statistics\n"
-	 "(in addition to iterations)")
+	 "(in addition to iterations)\n"
+	 "auto detects the warm-up of each thread (MSER-5), and trims it from statistics")
+	("rate", po::value<double>(&argrate),
+	 "open-loop mode: target arrival rate (Tnx/s), shared among threads\n"
+	 "latency is also measured from the intended start of each operation")
+	("profile", po::value< std::string >(),
+	 "load profile: successive phases of load, as level@seconds or from-to@seconds (ramp)\n"
+	 "levels are arrival rates (Tnx/s, open-loop), or numbers of threads when suffixed with 't'\n"
+	 "groups of phases can be repeated, e.g. [200@9,2000@1]*6 for bursts\n"
+	 "the run lasts for the whole profile; results are also given per phase")
+	("interval", po::value<double>(&arginterval)->default_value(0),
+	 "time series: TPS and latency are also given per interval of that many milliseconds\n"
+	 "0 disables the time series")
+	("percentiles", po::value< std::string >()->default_value("95,98,99"),
+	 "percentiles of latency to report, each with its 95% confidence interval, e.g. 50,99,99.9,99.99")
+	("bootstrap", po::value<int>(&argresamples)->default_value(0),
+	 "number of bootstrap resamples, to give percentiles and global TPS a bootstrap confidence interval\n"
+	 "0 disables the bootstrap")
+	("breakdown", "time init calls (e.g. C_EncryptInit), operation and cleanup (e.g. C_DestroyObject) apart,\n"
+	 "and report the latency distribution of each phase")
+	("histogram", po::value<int>(&arghistogram),
+	 "record latencies in a log-linear histogram per thread, with that many significant digits (1 to 5)\n"
+	 "memory no longer grows with the length of the run, but analyses needing each operation are not available")
+	("timer", po::value< std::string >()->default_value("steady"),
+	 "clock used to time operations: steady, monotonic-raw (Linux) or tsc (invariant TSC, x86)\n"
+	 "the cost of a timer read is measured at start, and taken off each latency")
+	("cpu-affinity", po::value< std::string >()->default_value("none"),
+	 help_text_affinity.c_str())
 	("json,j", "output results as JSON")
 	("jsonfile,o", po::value< std::string >(), "JSON output file name")
 	("datapoints,d", "add array of measured points to JSON output (requires -j/--json)")
+	("datapoints-file", po::value< std::string >(),
+	 "stream the datapoints of all test cases to that file, while they run\n"
+	 "with worker processes, each of them writes to the file name suffixed with its index")
+	("datapoints-format", po::value< std::string >()->default_value("csv"),
+	 "format of the datapoints file: csv or binary")
 	("coverage,c", po::value< std::string >()->default_value(default_tests),
 	 "coverage of test cases\n"
 	 "Note: the following test cases are compound:\n"
@@ -149,7 +231,19 @@ int main(int argc, char **argv)
 	 " - oaep = oaepsha1 + oaepsha256\n"
 	 " - oaepuwn = oaepunwsha1 + oaepunwsha256\n"
 	 " - oaepenc = oaepencsha1 + oaepencsha256\n"
-	 " - jwe  = jweoaepsha1 + jweoaepsha256")
+	 " - jwe  = jweoaepsha1 + jweoaepsha256\n"
+	 " - null = nullsessinfo + nullfnstatus + nullgetattr")
+	("baseline", po::value< std::string >(),
+	 "null operation run first, as a baseline: nullsessinfo, nullfnstatus or nullgetattr\n"
+	 "its average latency is taken off the average latency of the other test cases")
+	("mix", po::value< std::string >(),
+	 "mixed workload: test cases run together, each thread drawing the next operation according to weights\n"
+	 "e.g. aesgcm:60,ecdsa:30,oaepunw:10\n"
+	 "replaces the coverage of test cases")
+	("groups", po::value< std::string >(),
+	 "concurrent test cases, each on its own group of threads, e.g. rsa:16,aescbc:8\n"
+	 "each group is also run alone, and its results are compared to that baseline\n"
+	 "replaces the coverage of test cases and the number of threads")
 	("vectors,v", po::value< std::string >()->default_value(default_vectors), "test vectors to use")
 	("keysizes,k", po::value< std::string >()->default_value(default_keysizes), "key sizes or curves to use")
 	("flavour,f", po::value< std::string >()->default_value(default_flavour), help_text_flavour.c_str() )
@@ -157,7 +251,7 @@ int main(int argc, char **argv)
 
     envvars.add_options()
 	("library", po::value< std::string >(), "PKCS#11 library path\noverrides PKCS11LIB environment variable")
-	("slot", po::value<int>(&argslot), "slot index to use\noverrides PKCS11SLOT environment variable")
+	("slot", po::value< std::string >(), "slot index to use\noverrides PKCS11SLOT environment variable")
 	("password", po::value< std::string >(), "password for token in slot\noverrides PKCS11PASSWORD environment variable");
 
     po::variables_map vm;
@@ -176,8 +270,28 @@ int main(int argc, char **argv)
 	return EXIT_SUCCESS;      // exit prematurely
     }
 
+    // retrieve the mixed workload, if any. Its test cases replace the test coverage.
+    MixCoverage mix{ vm.count("mix") ? vm["mix"].as<std::string>() : "" };
+    if(vm.count("mix") && mix.empty()) {
+	std::cerr << "*** Error: no valid test case specified for the mix\n";
+	std::exit(EX_USAGE);
+    }
+
+    // retrieve the groups of threads, if any. Their test cases replace the test coverage.
+    GroupCoverage groups{ vm.count("groups") ? vm["groups"].as<std::string>() : "" };
+    if(vm.count("groups")) {
+	if(groups.empty()) {
+	    std::cerr << "*** Error: no valid group specified\n";
+	    std::exit(EX_USAGE);
+	}
+	if(!mix.empty() || !vm["threads"].defaulted()) {
+	    std::cerr << "*** Error: groups cannot be combined with --mix or -t/--threads\n";
+	    std::exit(EX_USAGE);
+	}
+    }
+
     // retrieve the test coverage
-    TestCoverage tests{ vm["coverage"].as<std::string>() };
+    TestCoverage tests{ !mix.empty() ? mix.tests() : !groups.empty() ? groups.tests() : vm["coverage"].as<std::string>() };
 
     // retrieve the vectors coverage
     VectorCoverage vectors{ vm["vectors"].as<std::string>() };
@@ -185,6 +299,14 @@ int main(int argc, char **argv)
     // retrieve the key size or curve coverage
     KeySizeCoverage keysizes{ vm["keysizes"].as<std::string>() };
 
+    // retrieve the numbers of threads (with groups, threads are those of all groups)
+    ThreadCoverage threads{ groups.empty() ? vm["threads"].as<std::string>() : std::to_string(groups.threads()) };
+    if(threads.empty()) {
+	std::cerr << "*** Error: no valid number of threads specified\n";
+	std::exit(EX_USAGE);
+    }
+    const int argnthreads = threads.max(); // sessions and session keys are created for the largest number of threads
+
     // retrieve the PKCS#11 implementation flavour
     Implementation::Vendor vendor;
     try {
@@ -195,6 +317,15 @@ int main(int argc, char **argv)
 	std::exit(EX_USAGE);
     }
 
+    // retrieve the CPU affinity policy
+    std::optional<CpuAffinity> affinity;
+    try {
+	affinity.emplace( vm["cpu-affinity"].as<std::string>() );
+    } catch(std::invalid_argument &e) {
+	std::cerr << "*** Error: " << e.what() << std::endl;
+	std::exit(EX_USAGE);
+    }
+
     if(vm.count("json")) {
 	json = true;
 
@@ -216,21 +347,323 @@ int main(int argc, char **argv)
 	}
     }
 
+    auto datapointsformat = DatapointWriter::parse(vm["datapoints-format"].as<std::string>());
+    if(!datapointsformat) {
+	std::cerr << "*** Error: the format of the datapoints file must be csv or binary\n";
+	std::exit(EX_USAGE);
+    }
+
+    // the timer is selected before worker processes are forked, so they inherit its calibration
+    auto timersource = Timer::parse(vm["timer"].as<std::string>());
+    if(!timersource) {
+	std::cerr << "*** Error: the timer must be steady, monotonic-raw or tsc\n";
+	std::exit(EX_USAGE);
+    }
+    try {
+	Timer::select(*timersource);
+    }
+    catch (std::invalid_argument &e) {
+	std::cerr << "*** Error: " << e.what() << '\n';
+	std::exit(EX_USAGE);
+    }
+
     if (vm.count("nogenerate")) {
 	generate_session_keys = false;
     }
 
-    if (vm.count("library")==0 || vm.count("password")==0 || argslot==-1) {
+    if (vm.count("library")==0 || vm.count("password")==0 || vm.count("slot")==0) {
 	std::cerr << "You must specify at leasr a path to a PKCS#11 library, a slot index and a password\n";
 	std::cerr << cliopts << '\n';
 	std::exit(EX_USAGE);
     }
 
-    if(argnthreads>hwthreads) {
-	std::cerr << "*** Warning: the specified number of threads (" << argnthreads << ") exceeds the hardware capacity on this platform (" << hwthreads << ").\n";
+    // retrieve the slots, and spread threads across them
+    SlotCoverage slotlist{ vm["slot"].as<std::string>() };
+    if(slotlist.empty()) {
+	std::cerr << "*** Error: no valid slot index specified\n";
+	std::exit(EX_USAGE);
+    }
+
+    if(vm.count("rate") && argrate<=0) {
+	std::cerr << "*** Error: the arrival rate must be a positive number\n";
+	std::exit(EX_USAGE);
+    }
+
+    std::optional<TimeWindow> window;
+    if(vm.count("duration")) {
+	if(argduration<=0 || argwarmup<0) {
+	    std::cerr << "*** Error: the duration must be a positive number, and the warm-up duration cannot be negative\n";
+	    std::exit(EX_USAGE);
+	}
+	window = TimeWindow { std::chrono::duration<double>(argwarmup), std::chrono::duration<double>(argduration) };
+    } else if(argwarmup>0) {
+	std::cerr << "When warmup option is used, --duration is mandatory\n";
+	std::cerr << cliopts << '\n';
+	std::exit(EX_USAGE);
+    }
+
+    // validated ahead of the load profile, which checks its number of threads against -t and --processes
+    if(argnprocesses<1) {
+	std::cerr << "*** Error: the number of processes must be a positive number\n";
+	std::exit(EX_USAGE);
+    }
+
+    std::optional<LoadProfile> profile;
+    if(vm.count("profile")) {
+	try {
+	    profile.emplace( vm["profile"].as<std::string>() );
+	} catch(std::invalid_argument &e) {
+	    std::cerr << "*** Error: " << e.what() << std::endl;
+	    std::exit(EX_USAGE);
+	}
+
+	if(vm.count("rate") || window) {
+	    std::cerr << "*** Error: a load profile cannot be combined with --rate, --duration or --warmup\n";
+	    std::exit(EX_USAGE);
+	}
+
+	if(profile->unit()==LoadProfile::Unit::threads) {
+	    if(threads.size()>1) {
+		std::cerr << "*** Error: a load profile of threads cannot be combined with a thread-count sweep\n";
+		std::exit(EX_USAGE);
+	    }
+	    if(profile->peak() > argnthreads*argnprocesses) {
+		std::cerr << "*** Error: the load profile needs up to " << profile->peak() << " threads, while only "
+			  << argnthreads*argnprocesses << " are available (see -t and --processes)\n";
+		std::exit(EX_USAGE);
+	    }
+	}
+
+	// the run lasts for the whole profile
+	window = TimeWindow { std::chrono::duration<double>(0), std::chrono::duration<double>(profile->duration()) };
+    }
+
+    // retrieve the number of iterations to skip, unless the warm-up is detected automatically
+    const bool autoskip = vm["skip"].as<std::string>()=="auto";
+    argskipiter = 0;
+    if(!autoskip) {
+	char *next = nullptr;
+	auto skip = vm["skip"].as<std::string>();
+	argskipiter = std::strtol(skip.c_str(), &next, 10);
+	if(skip.empty() || *next != '\0' || argskipiter<0) {
+	    std::cerr << "*** Error: the number of iterations to skip must be a non-negative number, or auto\n";
+	    std::exit(EX_USAGE);
+	}
+    } else if(profile) {
+	// trimming the start of the run would distort the first phases
+	std::cerr << "*** Error: --skip auto cannot be combined with --profile\n";
+	std::exit(EX_USAGE);
+    }
+
+    std::optional<Target> target;
+    if(vm.count("target-relerr")) {
+	auto spec = vm["target-relerr"].as<std::string>();
+	bool percent = !spec.empty() && spec.back()=='%';
+	if(percent) {
+	    spec.pop_back();
+	}
+	char *next = nullptr;
+	double relerr = std::strtod(spec.c_str(), &next);
+	if(percent) {
+	    relerr /= 100;
+	}
+	if(spec.empty() || *next != '\0' || !(relerr > 0 && relerr < 1)) {
+	    std::cerr << "*** Error: the target relative error must be between 0 and 1 (or 0% and 100%)\n";
+	    std::exit(EX_USAGE);
+	}
+	if(vm.count("max-iterations") && argmaxiter<argiter) {
+	    std::cerr << "*** Error: the maximum number of iterations cannot be less than the number of iterations of a batch (-i)\n";
+	    std::exit(EX_USAGE);
+	}
+	if(window || argnprocesses>1 || vm.count("groups")) {
+	    std::cerr << "*** Error: --target-relerr cannot be combined with --duration, --profile, --processes or --groups\n";
+	    std::exit(EX_USAGE);
+	}
+	target = Target { relerr, vm.count("target-p99")>0, static_cast<size_t>(vm.count("max-iterations") ? argmaxiter : 20*argiter) };
+    } else if(vm.count("target-p99") || vm.count("max-iterations")) {
+	std::cerr << "When target-p99 or max-iterations option is used, --target-relerr is mandatory\n";
+	std::cerr << cliopts << '\n';
+	std::exit(EX_USAGE);
+    }
+
+    if(!groups.empty() && (argnprocesses>1 || vm.count("rate") || profile)) {
+	std::cerr << "*** Error: groups cannot be combined with --processes, --rate or --profile\n";
+	std::exit(EX_USAGE);
+    }
+
+    if(argqueuedepth<1) {
+	std::cerr << "*** Error: the queue depth must be a positive number\n";
+	std::exit(EX_USAGE);
+    }
+
+    if(argqueuedepth>1 && (!groups.empty() || (profile && profile->unit()==LoadProfile::Unit::threads))) {
+	std::cerr << "*** Error: a queue depth cannot be combined with --groups or a load profile of threads\n";
+	std::exit(EX_USAGE);
+    }
+
+    if(arginterval<0) {
+	std::cerr << "*** Error: the interval of the time series cannot be negative\n";
+	std::exit(EX_USAGE);
+    }
+
+    if(argsessions<0) {
+	std::cerr << "*** Error: the number of sessions cannot be negative\n";
+	std::exit(EX_USAGE);
+    }
+
+    std::vector<double> percentiles;
+    {
+	std::stringstream list { vm["percentiles"].as<std::string>() };
+	std::string token;
+	while(std::getline(list, token, ',')) {
+	    char *next = nullptr;
+	    double pct = std::strtod(token.c_str(), &next);
+	    if(token.empty() || *next != '\0' || !(pct > 0 && pct < 100)) {
+		std::cerr << "*** Error: invalid percentile '" << token << "', percentiles must be between 0 and 100 (exclusive)\n";
+		std::exit(EX_USAGE);
+	    }
+	    percentiles.push_back(pct);
+	}
+    }
+
+    if(argresamples<0 || argresamples==1) {
+	std::cerr << "*** Error: the number of bootstrap resamples must be 0 (disabled), or at least 2\n";
+	std::exit(EX_USAGE);
+    }
+
+    // in histogram mode, operations are no longer recorded one by one: analyses that need them are ruled out
+    std::optional<int> histogram;
+    if(vm.count("histogram")) {
+	if(arghistogram<1 || arghistogram>5) {
+	    std::cerr << "*** Error: the precision of the histogram must be between 1 and 5 significant digits\n";
+	    std::exit(EX_USAGE);
+	}
+	if(vm.count("rate") || profile || argsessions>0 || !mix.empty() || arginterval>0 || autoskip || target || datapoints || vm.count("breakdown")) {
+	    std::cerr << "*** Error: --histogram cannot be combined with --rate, --profile, --sessions, --mix, --interval, --skip auto, --target-relerr, --breakdown or -d/--datapoints\n";
+	    std::exit(EX_USAGE);
+	}
+	histogram = arghistogram;
+    }
+
+    // the null-operation baseline runs before all other test cases
+    std::optional<P11NullBenchmark> baseline;
+    if(vm.count("baseline")) {
+	auto baselinename = vm["baseline"].as<std::string>();
+	if(baselinename == "nullsessinfo") {
+	    baseline.emplace("null-128", P11NullBenchmark::Call::GetSessionInfo);
+	} else if(baselinename == "nullfnstatus") {
+	    baseline.emplace("null-128", P11NullBenchmark::Call::GetFunctionStatus);
+	} else if(baselinename == "nullgetattr") {
+	    baseline.emplace("null-128", P11NullBenchmark::Call::GetAttributeValue);
+	} else {
+	    std::cerr << "*** Error: the baseline must be nullsessinfo, nullfnstatus or nullgetattr\n";
+	    std::exit(EX_USAGE);
+	}
+	if(!groups.empty()) {
+	    std::cerr << "*** Error: --baseline cannot be combined with --groups\n";
+	    std::exit(EX_USAGE);
+	}
+    }
+    // run options of the executor; thread slots, session pools, stream and worker processes are set once known
+    ExecutorOptions options;
+    options.generate_session_keys = generate_session_keys;
+    options.include_datapoints = datapoints;
+    options.rate = argrate;
+    options.window = window;
+    options.affinity = *affinity;
+    options.sharedsessions = argsessions;
+    options.profile = profile;
+    options.target = target;
+    options.autoskip = autoskip;
+    options.interval = milliseconds_double_t{arginterval};
+    options.queuedepth = argqueuedepth;
+    options.histogram = histogram;
+    options.percentiles = percentiles;
+    options.resamples = argresamples;
+    if(baseline) {
+	options.baseline = baseline->name() + " using " + baseline->label();
+    }
+    options.breakdown = vm.count("breakdown")>0;
+
+    if(argnthreads*argnprocesses>hwthreads) {
+	std::cerr << "*** Warning: the largest specified number of threads (" << argnthreads*argnprocesses << ") exceeds the hardware capacity on this platform (" << hwthreads << ").\n";
 	std::cerr << "*** TPS and latency figures may be affected.\n\n";
     }
 
+    // generate test vectors, according to command line requirements
+
+    std::map<const std::string, const std::vector<uint8_t> > testvecs;
+
+    for(auto vecsize: vectors) {
+	std::stringstream ss;
+	ss << "testvec" << std::setfill('0') << std::setw(4) << vecsize;
+	testvecs.emplace( std::make_pair( ss.str(), std::vector<uint8_t>(vecsize,0)) );
+    }
+
+    // add_results(): add the results of a benchmark.
+    // With a thread-count sweep, results are grouped per number of threads: each group receives the results of the benchmark.
+    // (the benchmark name may contain dots, so we avoid path-based accessors here)
+    auto add_results = [&](const std::string &benchmarkname, pt::ptree outcome) {
+	if(threads.size()>1) {
+	    for(auto &group: outcome) {
+		auto found = results.find(group.first);
+		auto &target = found == results.not_found() ?
+		    results.push_back(std::make_pair(group.first, pt::ptree()))->second :
+		    found->second;
+		target.push_back(std::make_pair(benchmarkname, group.second));
+	    }
+	} else {
+	    results.add_child( benchmarkname, outcome );
+	}
+    };
+
+    auto write_results = [&]() {
+	if(json==true) {
+	    boost::property_tree::write_json(jsonout.is_open() ? jsonout : std::cout, results);
+	    if(jsonout.is_open()) {
+		std::cout << "output written to " << vm["jsonfile"].as<std::string>() << '\n';
+	    }
+	}
+    };
+
+    // in multi-process mode, worker processes are forked before the PKCS#11 library is loaded,
+    // so each of them has its own instance. The parent only collects and reports measurements.
+    std::optional<ProcessGroup> processes;
+    if(argnprocesses>1) {
+	processes.emplace(argnprocesses);
+
+	if(processes->is_parent()) {
+	    std::vector<std::unique_ptr<p11::Session> > nosessions;
+	    auto epsilon = measure_clock_precision();
+
+	    try {
+		options.threadslots = slotlist.assign(argnthreads*argnprocesses);
+		options.processes = &*processes;
+		Executor executor( testvecs, nosessions, threads, epsilon, options );
+		for(auto &[benchmarkname, outcome]: executor.aggregate( argiter, argskipiter )) {
+		    add_results( benchmarkname, outcome );
+		}
+		write_results();
+	    }
+	    catch ( std::exception &e) {
+		std::cerr << "Ouch, got an error while collecting results from worker processes: " << e.what() << '\n'
+			  << "bailing out" << std::endl;
+		rv = EX_SOFTWARE;
+	    }
+
+	    if(!processes->wait()) {
+		std::cerr << "*** Error: at least one worker process failed\n";
+		rv = EX_SOFTWARE;
+	    }
+	    return rv;
+	}
+
+	// only the first worker process prints library, slot and token details
+	if(processes->index()>0) {
+	    std::freopen("/dev/null", "w", stdout);
+	}
+    }
+
     p11::Module module( vm["library"].as<std::string>() );
 
     p11::Info info = module.get_info();
@@ -249,64 +682,85 @@ int main(int argc, char **argv)
     // only slots with connected token
     std::vector<p11::SlotId> slotids = p11::Slot::get_available_slots( module, false );
 
-    p11::Slot slot( module, slotids.at( argslot ) );
-
-    // print chosen slot index
-    std::cout << "Slot index: " << vm["slot"].as<int>() << '\n';
-    // print chosen slot index
-    std::cout << "Slot number: " << slotids.at(argslot) << " (0x" << std::hex << slotids.at(argslot) << std::dec << ")\n";
-    // print firmware version of the slot
-    p11::SlotInfo slot_info = slot.get_slot_info();
-
-    // print slot description
-    std::string_view slot_description { reinterpret_cast<const char *>(slot_info.slotDescription), sizeof(slot_info.slotDescription) };
-    std::cout << "Slot description: " << slot_description << '\n';
-
-    // print token manufacturer ID
-    std::string_view manufacturer_id { reinterpret_cast<const char *>(slot_info.manufacturerID), sizeof(slot_info.manufacturerID) };
-    std::cout << "Slot manufacturerID: " << manufacturer_id << '\n';
-
-    std::cout << "Slot hardware version: "
-	      << std::to_string( slot_info.hardwareVersion.major ) << '.'
-	      << std::to_string( slot_info.hardwareVersion.minor ) << '\n';
-    std::cout << "Slot firmware version: "
-	      << std::to_string( slot_info.firmwareVersion.major ) << '.'
-	      << std::to_string( slot_info.firmwareVersion.minor ) << '\n';
+    std::vector<p11::Slot> slots;
+    bool tokens_present = true;
+
+    for(auto slotindex: slotlist.indices()) {
+	slots.emplace_back( module, slotids.at( slotindex ) );
+	auto &slot = slots.back();
+
+	// print chosen slot index
+	std::cout << "Slot index: " << slotindex << '\n';
+	// print chosen slot index
+	std::cout << "Slot number: " << slotids.at(slotindex) << " (0x" << std::hex << slotids.at(slotindex) << std::dec << ")\n";
+	// print firmware version of the slot
+	p11::SlotInfo slot_info = slot.get_slot_info();
+
+	// print slot description
+	std::string_view slot_description { reinterpret_cast<const char *>(slot_info.slotDescription), sizeof(slot_info.slotDescription) };
+	std::cout << "Slot description: " << slot_description << '\n';
+
+	// print token manufacturer ID
+	std::string_view manufacturer_id { reinterpret_cast<const char *>(slot_info.manufacturerID), sizeof(slot_info.manufacturerID) };
+	std::cout << "Slot manufacturerID: " << manufacturer_id << '\n';
+
+	std::cout << "Slot hardware version: "
+		  << std::to_string( slot_info.hardwareVersion.major ) << '.'
+		  << std::to_string( slot_info.hardwareVersion.minor ) << '\n';
+	std::cout << "Slot firmware version: "
+		  << std::to_string( slot_info.firmwareVersion.major ) << '.'
+		  << std::to_string( slot_info.firmwareVersion.minor ) << '\n';
+
+	// detect if we have a token inserted
+	if(!(slot_info.flags & CKF_TOKEN_PRESENT)) {
+	    std::cout << "The slot at index " << slotindex << " has no token. Aborted.\n";
+	    tokens_present = false;
+	    break;
+	}
+    }
 
-    // detect if we have a token inserted
-    if(slot_info.flags & CKF_TOKEN_PRESENT) {
+    if(tokens_present) {
 	try {
-	    p11::TokenInfo token_info = slot.get_token_info();
-
-	    // print token label
-	    std::string_view label { reinterpret_cast<const char *>(token_info.label), sizeof(token_info.label) };
-	    std::cout << "Token label: " << label << '\n';
-
-	    // print token manufacturer ID
-	    std::string_view manufacturer_id { reinterpret_cast<const char *>(token_info.manufacturerID), sizeof(token_info.manufacturerID) };
-	    std::cout << "Token manufacturerID: " << manufacturer_id << '\n';
-
-	    // print token model
-	    std::string_view model { reinterpret_cast<const char *>(token_info.model), sizeof(token_info.model) };
-	    std::cout << "Token model: " << model << '\n';
-
-	    // print token serial number
-	    std::string_view serial_number { reinterpret_cast<const char *>(token_info.serialNumber), sizeof(token_info.serialNumber) };
-	    std::cout << "Token S/N: " << serial_number << '\n';
-
-	    // print hardware version of the token
-	    std::cout << "Token hardware version: "
-		      << std::to_string( token_info.hardwareVersion.major ) << '.'
-		      << std::to_string( token_info.hardwareVersion.minor ) << '\n';
-
-	    // print firmware version of the token
-	    std::cout << "Token firmware version: "
-		      << std::to_string( token_info.firmwareVersion.major ) << '.'
-		      << std::to_string( token_info.firmwareVersion.minor ) << '\n';
+	    for(auto &slot: slots) {
+		p11::TokenInfo token_info = slot.get_token_info();
+
+		// print token label
+		std::string_view label { reinterpret_cast<const char *>(token_info.label), sizeof(token_info.label) };
+		std::cout << "Token label: " << label << '\n';
+
+		// print token manufacturer ID
+		std::string_view manufacturer_id { reinterpret_cast<const char *>(token_info.manufacturerID), sizeof(token_info.manufacturerID) };
+		std::cout << "Token manufacturerID: " << manufacturer_id << '\n';
+
+		// print token model
+		std::string_view model { reinterpret_cast<const char *>(token_info.model), sizeof(token_info.model) };
+		std::cout << "Token model: " << model << '\n';
+
+		// print token serial number
+		std::string_view serial_number { reinterpret_cast<const char *>(token_info.serialNumber), sizeof(token_info.serialNumber) };
+		std::cout << "Token S/N: " << serial_number << '\n';
+
+		// print hardware version of the token
+		std::cout << "Token hardware version: "
+			  << std::to_string( token_info.hardwareVersion.major ) << '.'
+			  << std::to_string( token_info.hardwareVersion.minor ) << '\n';
+
+		// print firmware version of the token
+		std::cout << "Token firmware version: "
+			  << std::to_string( token_info.firmwareVersion.major ) << '.'
+			  << std::to_string( token_info.firmwareVersion.minor ) << '\n';
+	    }
 
-	    // login all sessions (one per thread)
+	    // login all sessions (one per thread, or per lane with a queue depth), each on the slot it is assigned to.
+	    // Session keys are generated through these sessions, and therefore land on the slot of their thread.
+	    // (with worker processes, threads are assigned across all processes, see Executor::global_index())
+	    auto threadslots = slotlist.assign(argnthreads*argnprocesses);
+	    const int procindex = processes ? processes->index() : 0;
+	    const int arglanes = argnthreads*argqueuedepth; // workers of this process, see Executor::client_index()
+	    auto slotindices = slotlist.indices();
 	    std::vector<std::unique_ptr<p11::Session> > sessions;
-	    for(int i=0; i<argnthreads; ++i) {
+	    for(int i=0; i<arglanes; ++i) {
+		auto &slot = slots.at( std::find(slotindices.begin(), slotindices.end(), threadslots[(i/argqueuedepth)*argnprocesses+procindex]) - slotindices.begin() );
 		std::unique_ptr<p11::Session> session ( new Session(slot, false) );
 		std::string argpwd { vm["password"].as<std::string>() };
 		p11::secure_string pwd( argpwd.data(), argpwd.data()+argpwd.length() );
@@ -323,28 +777,52 @@ int main(int argc, char **argv)
 		sessions.push_back(std::move(session)); // move session to sessions
 	    }
 
-	    // generate test vectors, according to command line requirements
-
-	    std::map<const std::string, const std::vector<uint8_t> > testvecs;
-
-	    for(auto vecsize: vectors) {
-		std::stringstream ss;
-		ss << "testvec" << std::setfill('0') << std::setw(4) << vecsize;
-		testvecs.emplace( std::make_pair( ss.str(), std::vector<uint8_t>(vecsize,0)) );
+	    // with shared sessions, each slot has a pool of sessions, in addition to the sessions of its threads.
+	    // The latter are only used to find objects, generate session keys, prepare and tear down test cases.
+	    // (login status is shared accross all sessions, pool sessions need no login)
+	    std::vector<std::unique_ptr<SessionPool> > pools;
+	    std::vector<SessionPool *> threadpools;
+	    if(argsessions>0) {
+		for(auto &slot: slots) {
+		    std::vector<std::unique_ptr<p11::Session> > poolsessions;
+		    for(int i=0; i<argsessions; ++i) {
+			poolsessions.emplace_back( new Session(slot, false) );
+		    }
+		    pools.emplace_back( new SessionPool(std::move(poolsessions)) );
+		}
+		for(int i=0; i<arglanes; ++i) {
+		    auto slotposition = std::find(slotindices.begin(), slotindices.end(), threadslots[(i/argqueuedepth)*argnprocesses+procindex]) - slotindices.begin();
+		    threadpools.push_back( pools.at(slotposition).get() );
+		}
 	    }
 
 	    auto epsilon = measure_clock_precision();
-	    std::cout << std::endl << "timer granularity (ns): " << epsilon.first.count() << " +/- " << epsilon.second.count() << "\n\n";
+	    std::cout << std::endl << "timer: " << Timer::name() << ", read overhead (ns): " << Timer::overhead().count() << '\n';
+	    std::cout << "timer granularity (ns): " << epsilon.first.count() << " +/- " << epsilon.second.count() << "\n\n";
+
+	    // datapoints are streamed from every session, i.e. from every lane
+	    std::optional<DatapointWriter> stream;
+	    if(vm.count("datapoints-file")) {
+		auto path = vm["datapoints-file"].as<std::string>();
+		if(processes) {
+		    path += '.' + std::to_string(processes->index());
+		}
+		stream.emplace(path, *datapointsformat, arglanes);
+	    }
 
-	    Executor executor( testvecs, sessions, argnthreads, epsilon, generate_session_keys==true, datapoints );
+	    options.threadslots = threadslots;
+	    options.threadpools = threadpools;
+	    options.stream = stream ? &*stream : nullptr;
+	    options.processes = processes ? &*processes : nullptr;
+	    Executor executor( testvecs, sessions, threads, epsilon, options );
 	    // Track which keys were successfully generated
 	    std::set<std::string> generated_keys;
 
 	    // TODO: replace this whole spaghetti-like section with a more modular approach. Keys needed could be inferred from object classes.
 	    if(generate_session_keys) {
-		KeyGenerator keygenerator( sessions, argnthreads, vendor );
+		KeyGenerator keygenerator( sessions, arglanes, vendor );
 
-		std::cout << "Generating session keys for " << argnthreads << " thread(s)\n";
+		std::cout << "Generating session keys for " << arglanes << " thread(s)\n";
 		if(tests.contains("rsa")
 		   || tests.contains("rsapss")
 		   || tests.contains("jwe")
@@ -519,6 +997,18 @@ int main(int argc, char **argv)
 		    generated_keys.insert("find-128"); // always insert, tests don't really need this key
 		}
 
+		if(baseline
+		   || tests.contains("null")
+		   || tests.contains("nullsessinfo")
+		   || tests.contains("nullfnstatus")
+		   || tests.contains("nullgetattr")) {
+		    if(keygenerator.generate_key(KeyGenerator::KeyType::AES, "null-128", 128)) {
+			generated_keys.insert("null-128");
+		    } else {
+			std::cerr << "WARNING: Failed to generate key 'null-128', associated tests will be skipped\n";
+		    }
+		}
+
 	    } else {
 		
 		std::cout << "Using existing token keys (no generation)\n";
@@ -549,6 +1039,7 @@ int main(int argc, char **argv)
 		generated_keys.insert("xorder-128");
 		generated_keys.insert("rand-128");
 		generated_keys.insert("find-128");
+		generated_keys.insert("null-128");
 	    }
 
 	    // Helper lambda to check if key was generated (C++11 compatible)
@@ -556,198 +1047,272 @@ int main(int argc, char **argv)
 		return generated_keys.find(key) != generated_keys.end();
 	    };
 
-	    std::forward_list<P11Benchmark *> benchmarks;
+	    // select_benchmarks(): build the benchmarks of a test coverage, for the requested key sizes
+	    auto select_benchmarks = [&](TestCoverage &tests) {
+		std::forward_list<P11Benchmark *> benchmarks;
 
-	    // RSA PKCS#1 signature
-	    if(tests.contains("rsa")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-2048") );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-3072") );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-4096") );
-	    }
+		// RSA PKCS#1 signature
+		if(tests.contains("rsa")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-2048") );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-3072") );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11RSASigBenchmark("rsa-4096") );
+		}
 
-	    // RSA-PSS signature
-	    if(tests.contains("rsapss")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-2048") );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-3072") );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-4096") );
-	    }
+		// RSA-PSS signature
+		if(tests.contains("rsapss")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-2048") );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-3072") );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11RSAPssBenchmark("rsa-4096") );
+		}
 
-	    // RSA PKCS#1 OAEP decryption
-	    if(tests.contains("oaep") || tests.contains("oaepsha1")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-2048", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-3072", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-4096", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
-	    }
+		// RSA PKCS#1 OAEP decryption
+		if(tests.contains("oaep") || tests.contains("oaepsha1")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-2048", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-3072", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-4096", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA1) );
+		}
 
-	    if(tests.contains("oaep") || tests.contains("oaepsha256")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-2048", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-3072", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-4096", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
-	    }
+		if(tests.contains("oaep") || tests.contains("oaepsha256")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-2048", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-3072", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPDecryptBenchmark("rsa-4096", vendor, P11OAEPDecryptBenchmark::HashAlg::SHA256) );
+		}
 
-	    // RSA PKCS#1 OAEP encryption
-	    if(tests.contains("oaepenc") || tests.contains("oaepencsha1")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-2048", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-3072", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-4096", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
-	    }
+		// RSA PKCS#1 OAEP encryption
+		if(tests.contains("oaepenc") || tests.contains("oaepencsha1")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-2048", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-3072", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-4096", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA1) );
+		}
 
-	    if(tests.contains("oaepenc") || tests.contains("oaepencsha256")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-2048", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-3072", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-4096", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
-	    }
+		if(tests.contains("oaepenc") || tests.contains("oaepencsha256")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-2048", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-3072", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPEncryptBenchmark("rsa-4096", vendor, P11OAEPEncryptBenchmark::HashAlg::SHA256) );
+		}
 
-	    // RSA PKCS#1 OAEP unwrapping
-	    if(tests.contains("oaepunw") || tests.contains("oaepunwsha1")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-2048", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-3072", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-4096", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
-	    }
+		// RSA PKCS#1 OAEP unwrapping
+		if(tests.contains("oaepunw") || tests.contains("oaepunwsha1")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-2048", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-3072", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-4096", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA1) );
+		}
 
-	    if(tests.contains("oaepunw") || tests.contains("oaepunwsha256")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-2048", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-3072", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-4096", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
-	    }
+		if(tests.contains("oaepunw") || tests.contains("oaepunwsha256")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-2048", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-3072", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) benchmarks.emplace_front( new P11OAEPUnwrapBenchmark("rsa-4096", vendor, P11OAEPUnwrapBenchmark::HashAlg::SHA256) );
+		}
 
-	    // JWE ( RSA OAEP + AES GCM )
-	    // for JWE, we don't need to check has_key("") for AES, as these are session keys generated on the fly for each iteration of the benchmark, 
-	    // and not persistent keys generated beforehand. We only check for the presence of RSA keys, which are needed for the key encryption step of JWE.
-	    if(tests.contains("jwe") || tests.contains("jweoaepsha1")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) {
-		    if(keysizes.contains("aes128") )
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
-		}
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) {
-		    if(keysizes.contains("aes128"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
-		}
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) {
-		    if(keysizes.contains("aes128"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
+		// JWE ( RSA OAEP + AES GCM )
+		// for JWE, we don't need to check has_key("") for AES, as these are session keys generated on the fly for each iteration of the benchmark, 
+		// and not persistent keys generated beforehand. We only check for the presence of RSA keys, which are needed for the key encryption step of JWE.
+		if(tests.contains("jwe") || tests.contains("jweoaepsha1")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) {
+			if(keysizes.contains("aes128") )
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) {
+			if(keysizes.contains("aes128"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) {
+			if(keysizes.contains("aes128"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA1, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
 		}
-	    }
 
-	    if(tests.contains("jwe") || tests.contains("jweoaepsha256")) {
-		if(keysizes.contains("rsa2048") && has_key("rsa-2048")) {
-		    if(keysizes.contains("aes128"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
-		}
-		if(keysizes.contains("rsa3072") && has_key("rsa-3072")) {
-		    if(keysizes.contains("aes128"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
-		}
-		if(keysizes.contains("rsa4096") && has_key("rsa-4096")) {
-		    if(keysizes.contains("aes128"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
-		    if(keysizes.contains("aes192"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
-		    if(keysizes.contains("aes256"))
-			benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
+		if(tests.contains("jwe") || tests.contains("jweoaepsha256")) {
+		    if(keysizes.contains("rsa2048") && has_key("rsa-2048")) {
+			if(keysizes.contains("aes128"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-2048", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
+		    if(keysizes.contains("rsa3072") && has_key("rsa-3072")) {
+			if(keysizes.contains("aes128"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-3072", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
+		    if(keysizes.contains("rsa4096") && has_key("rsa-4096")) {
+			if(keysizes.contains("aes128"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM128) );
+			if(keysizes.contains("aes192"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM192) );
+			if(keysizes.contains("aes256"))
+			    benchmarks.emplace_front( new P11JWEBenchmark("rsa-4096", vendor, P11JWEBenchmark::HashAlg::SHA256, P11JWEBenchmark::SymAlg::GCM256) );
+		    }
 		}
-	    }
 
-	    if(tests.contains("ecdsa")) {
-		if(keysizes.contains("ecnistp256") && has_key("ecdsa-secp256r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp256r1") );
-		if(keysizes.contains("ecnistp384") && has_key("ecdsa-secp384r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp384r1") );
-		if(keysizes.contains("ecnistp521") && has_key("ecdsa-secp521r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp521r1") );
-	    }
+		if(tests.contains("ecdsa")) {
+		    if(keysizes.contains("ecnistp256") && has_key("ecdsa-secp256r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp256r1") );
+		    if(keysizes.contains("ecnistp384") && has_key("ecdsa-secp384r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp384r1") );
+		    if(keysizes.contains("ecnistp521") && has_key("ecdsa-secp521r1")) benchmarks.emplace_front( new P11ECDSASigBenchmark("ecdsa-secp521r1") );
+		}
 
-	    if(tests.contains("ecdh")) {
-		if(keysizes.contains("ecnistp256") && has_key("ecdh-secp256r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp256r1") );
-		if(keysizes.contains("ecnistp384") && has_key("ecdh-secp384r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp384r1") );
-		if(keysizes.contains("ecnistp521") && has_key("ecdh-secp521r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp521r1") );
-	    }
+		if(tests.contains("ecdh")) {
+		    if(keysizes.contains("ecnistp256") && has_key("ecdh-secp256r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp256r1") );
+		    if(keysizes.contains("ecnistp384") && has_key("ecdh-secp384r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp384r1") );
+		    if(keysizes.contains("ecnistp521") && has_key("ecdh-secp521r1")) benchmarks.emplace_front( new P11ECDH1DeriveBenchmark("ecdh-secp521r1") );
+		}
 
-	    if(tests.contains("hmac")) {
-		if(keysizes.contains("hmac160") && has_key("hmac-160")) benchmarks.emplace_front( new P11HMACSHA1Benchmark("hmac-160") );
-		if(keysizes.contains("hmac256") && has_key("hmac-256")) benchmarks.emplace_front( new P11HMACSHA256Benchmark("hmac-256") );
-		if(keysizes.contains("hmac512") && has_key("hmac-512")) benchmarks.emplace_front( new P11HMACSHA512Benchmark("hmac-512") );
-	    }
+		if(tests.contains("hmac")) {
+		    if(keysizes.contains("hmac160") && has_key("hmac-160")) benchmarks.emplace_front( new P11HMACSHA1Benchmark("hmac-160") );
+		    if(keysizes.contains("hmac256") && has_key("hmac-256")) benchmarks.emplace_front( new P11HMACSHA256Benchmark("hmac-256") );
+		    if(keysizes.contains("hmac512") && has_key("hmac-512")) benchmarks.emplace_front( new P11HMACSHA512Benchmark("hmac-512") );
+		}
 
-	    if(tests.contains("des") || tests.contains("desecb")) {
-		if(keysizes.contains("des128") && has_key("des-128")) benchmarks.emplace_front( new P11DES3ECBBenchmark("des-128") );
-		if(keysizes.contains("des192") && has_key("des-192")) benchmarks.emplace_front( new P11DES3ECBBenchmark("des-192") );
-	    }
+		if(tests.contains("des") || tests.contains("desecb")) {
+		    if(keysizes.contains("des128") && has_key("des-128")) benchmarks.emplace_front( new P11DES3ECBBenchmark("des-128") );
+		    if(keysizes.contains("des192") && has_key("des-192")) benchmarks.emplace_front( new P11DES3ECBBenchmark("des-192") );
+		}
 
-	    if(tests.contains("des") || tests.contains("descbc")) {
-		if(keysizes.contains("des128") && has_key("des-128")) benchmarks.emplace_front( new P11DES3CBCBenchmark("des-128") );
-		if(keysizes.contains("des192") && has_key("des-192")) benchmarks.emplace_front( new P11DES3CBCBenchmark("des-192") );
-	    }
+		if(tests.contains("des") || tests.contains("descbc")) {
+		    if(keysizes.contains("des128") && has_key("des-128")) benchmarks.emplace_front( new P11DES3CBCBenchmark("des-128") );
+		    if(keysizes.contains("des192") && has_key("des-192")) benchmarks.emplace_front( new P11DES3CBCBenchmark("des-192") );
+		}
 
-	    if(tests.contains("aes") || tests.contains("aesecb")) {
-		if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-128") );
-		if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-192") );
-		if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-256") );
-	    }
+		if(tests.contains("aes") || tests.contains("aesecb")) {
+		    if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-128") );
+		    if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-192") );
+		    if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESECBBenchmark("aes-256") );
+		}
 
-	    if(tests.contains("aes") || tests.contains("aescbc")) {
-		if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-128") );
-		if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-192") );
-		if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-256") );
-	    }
+		if(tests.contains("aes") || tests.contains("aescbc")) {
+		    if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-128") );
+		    if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-192") );
+		    if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESCBCBenchmark("aes-256") );
+		}
 
-	    if(tests.contains("aes") || tests.contains("aesgcm")) {
-		if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-128", vendor) );
-		if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-192", vendor) );
-		if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-256", vendor) );
-	    }
+		if(tests.contains("aes") || tests.contains("aesgcm")) {
+		    if(keysizes.contains("aes128") && has_key("aes-128")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-128", vendor) );
+		    if(keysizes.contains("aes192") && has_key("aes-192")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-192", vendor) );
+		    if(keysizes.contains("aes256") && has_key("aes-256")) benchmarks.emplace_front( new P11AESGCMBenchmark("aes-256", vendor) );
+		}
 
-	    if(tests.contains("xorder")) {
-		if(has_key("xorder-128")) benchmarks.emplace_front( new P11XorKeyDataDeriveBenchmark("xorder-128") );
-	    }
+		if(tests.contains("xorder")) {
+		    if(has_key("xorder-128")) benchmarks.emplace_front( new P11XorKeyDataDeriveBenchmark("xorder-128") );
+		}
 
-	    if(tests.contains("rand")) {
-		if(has_key("rand-128")) {
-		    benchmarks.emplace_front( new P11SeedRandomBenchmark("rand-128") );
-		    benchmarks.emplace_front( new P11GenerateRandomBenchmark("rand-128") );
+		if(tests.contains("rand")) {
+		    if(has_key("rand-128")) {
+			benchmarks.emplace_front( new P11SeedRandomBenchmark("rand-128") );
+			benchmarks.emplace_front( new P11GenerateRandomBenchmark("rand-128") );
+		    }
+		}
+
+		if(tests.contains("find")) {
+		    if(has_key("find-128")) {
+			benchmarks.emplace_front( new P11FindObjectsBenchmark("find-128") );
+		    }
 		}
-	    }
 
-	    if(tests.contains("find")) {
-		if(has_key("find-128")) {
-		    benchmarks.emplace_front( new P11FindObjectsBenchmark("find-128") );
+		if(has_key("null-128")) {
+		    if(tests.contains("null") || tests.contains("nullsessinfo")) benchmarks.emplace_front( new P11NullBenchmark("null-128", P11NullBenchmark::Call::GetSessionInfo) );
+		    if(tests.contains("null") || tests.contains("nullfnstatus")) benchmarks.emplace_front( new P11NullBenchmark("null-128", P11NullBenchmark::Call::GetFunctionStatus) );
+		    if(tests.contains("null") || tests.contains("nullgetattr")) benchmarks.emplace_front( new P11NullBenchmark("null-128", P11NullBenchmark::Call::GetAttributeValue) );
+		}
+		benchmarks.reverse();
+		return benchmarks;
+	    };
+
+	    std::forward_list<P11Benchmark *> benchmarks;
+	    std::vector<std::pair<P11Benchmark *, int> > concurrent; // benchmark and number of threads of each group
+
+	    if(!groups.empty()) {
+		// each group runs a single benchmark: its test case must stand for one key size only
+		for(auto &[testcase, numthreads]: groups) {
+		    TestCoverage grouptests{ testcase };
+		    auto selected = select_benchmarks(grouptests);
+		    auto count = std::distance(selected.begin(), selected.end());
+		    if(count==1) {
+			concurrent.emplace_back(selected.front(), numthreads);
+			continue;
+		    }
+		    std::cerr << "*** Error: test case '" << testcase << "' of the groups stands for " << count
+			      << " benchmarks, while exactly one is needed (see -k)\n";
+		    for(auto benchmark: selected) {
+			delete benchmark;
+		    }
+		    rv = EX_USAGE;
+		}
+	    } else if(mix.empty()) {
+		benchmarks = select_benchmarks(tests);
+	    } else {
+		// each test case of the mix gets its weight, split evenly among the benchmarks it stands for
+		// (e.g. one per key size)
+		std::vector<std::pair<std::unique_ptr<P11Benchmark>, double> > operations;
+		for(auto &[testcase, weight]: mix) {
+		    TestCoverage mixtests{ testcase };
+		    auto selected = select_benchmarks(mixtests);
+		    auto count = std::distance(selected.begin(), selected.end());
+		    if(count==0) {
+			std::cerr << "*** Warning: no benchmark available for test case '" << testcase << "' of the mix, skipping\n";
+			continue;
+		    }
+		    for(auto benchmark: selected) {
+			operations.emplace_back(benchmark, weight / count);
+		    }
+		}
+		if(!operations.empty()) {
+		    benchmarks.push_front( new P11MixBenchmark("Mixed workload (" + vm["mix"].as<std::string>() + ")", "mix", std::move(operations)) );
 		}
 	    }
-	    benchmarks.reverse();
 
 
 	    std::forward_list<std::string> testvecsnames;
 	    boost::copy(testvecs | boost::adaptors::map_keys, std::front_inserter(testvecsnames));
 	    testvecsnames.sort();	// sort in alphabetical order
 
-	    for(auto benchmark : benchmarks) {
-		results.add_child( benchmark->name()+" using "+benchmark->label(), executor.benchmark( *benchmark, argiter, argskipiter, testvecsnames ));
-		free(benchmark);
+	    // the baseline needs a single test vector, as its payload is ignored, unless it is also part of the coverage
+	    if(baseline && has_key("null-128")) {
+		bool covered = false;
+		benchmarks.remove_if([&](P11Benchmark *benchmark) {
+		    if(benchmark->name() + " using " + benchmark->label() != *options.baseline) {
+			return false;
+		    }
+		    delete benchmark;
+		    return covered = true;
+		});
+		add_results( *options.baseline, executor.benchmark( *baseline, argiter, argskipiter, covered ? testvecsnames : std::forward_list<std::string>{ testvecsnames.front() } ) );
 	    }
 
-	    if(json==true) {
-		boost::property_tree::write_json(jsonout.is_open() ? jsonout : std::cout, results);
-		if(jsonout.is_open()) {
-		    std::cout << "output written to " << vm["jsonfile"].as<std::string>() << '\n';
+	    if(groups.empty()) {
+		for(auto benchmark : benchmarks) {
+		    add_results( benchmark->name()+" using "+benchmark->label(), executor.benchmark( *benchmark, argiter, argskipiter, testvecsnames ) );
+		    delete benchmark;
+		}
+	    } else if(rv == EXIT_SUCCESS) {
+		for(auto &[benchmarkname, outcome]: executor.concurrent( concurrent, argiter, argskipiter, testvecsnames )) {
+		    add_results( benchmarkname, outcome );
 		}
 	    }
+
+	    for(auto &group: concurrent) {
+		delete group.first;
+	    }
+
+	    // worker processes have sent their measurements to the parent, that writes results
+	    if(!processes) {
+		write_results();
+	    }
 	}
 	catch ( std::exception &e) {
 	    std::cerr << "Ouch, got an error while execution: " << e.what() << '\n'
@@ -763,8 +1328,6 @@ int main(int argc, char **argv)
 		      << "bailing out" << std::endl;
 	    rv = EX_SOFTWARE;
 	}
-    } else {
-	std::cout << "The slot at index " << argslot << " has no token. Aborted.\n";
     }
     return rv;
 }
@@ -57,5 +57,6 @@ void P11RSAPssBenchmark::crashtestdummy(Session &session)
 {
     Ulong signature_len = m_signature.size();
     session.module()->C_SignInit(session.handle(), &m_mech_rsa_pss, m_objhandle);
+    split_timer(Phase::init);
     session.module()->C_Sign(session.handle(), m_hash.data(), m_hash.size(), m_signature.data(), &signature_len);
 }
@@ -27,7 +27,6 @@ P11RSASigBenchmark::P11RSASigBenchmark(const P11RSASigBenchmark & other) :
 {
     // we don't want to copy specific members,
     // the only we need to matter for m_rng
-    m_rsakey = nullptr;
     m_signer = nullptr;
     m_rng.force_reseed();
 }
@@ -39,11 +38,28 @@ inline P11RSASigBenchmark *P11RSASigBenchmark::clone() const {
 
 void P11RSASigBenchmark::prepare(Session &session, Object &obj, std::optional<size_t> threadindex)
 {
-    m_rsakey = std::unique_ptr<PKCS11_RSA_PrivateKey>(new PKCS11_RSA_PrivateKey(session, obj.handle()));
-    m_signer = std::unique_ptr<Botan::PK_Signer>(new Botan::PK_Signer( *m_rsakey,
-								       m_rng,
-								       "EMSA3(SHA-256)",
-								       Botan::Signature_Format::IEEE_1363 ));
+    m_signers.clear();
+    m_signer = signer(session, obj.handle());
+}
+
+void P11RSASigBenchmark::rebind(Session &session, Object &obj)
+{
+    m_signer = signer(session, obj.handle());
+}
+
+Botan::PK_Signer *P11RSASigBenchmark::signer(Session &session, ObjectHandle handle)
+{
+    auto &entry = m_signers[session.handle()];
+
+    if(!entry.second) {
+	entry.first = std::unique_ptr<PKCS11_RSA_PrivateKey>(new PKCS11_RSA_PrivateKey(session, handle));
+	entry.second = std::unique_ptr<Botan::PK_Signer>(new Botan::PK_Signer( *entry.first,
+									      m_rng,
+									      "EMSA3(SHA-256)",
+									      Botan::Signature_Format::IEEE_1363 ));
+    }
+
+    return entry.second.get();
 }
 
 void P11RSASigBenchmark::crashtestdummy(Session &session)
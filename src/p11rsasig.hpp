@@ -19,6 +19,7 @@
 #if !defined P11RSASIG_HPP
 #define P11RSASIG_HPP
 
+#include <map>
 #include "p11benchmark.hpp"
 
 // ============================================================================
@@ -59,13 +60,19 @@
 class P11RSASigBenchmark : public P11Benchmark
 {
     Botan::AutoSeeded_RNG m_rng;
-    std::unique_ptr<PKCS11_RSA_PrivateKey> m_rsakey;
-    std::unique_ptr<Botan::PK_Signer> m_signer;
+    // Botan key objects are bound to the session they are created with. With a session pool,
+    // a key and a signer are kept per session, and m_signer points to these of the current session.
+    std::map<SessionHandle, std::pair<std::unique_ptr<PKCS11_RSA_PrivateKey>, std::unique_ptr<Botan::PK_Signer> > > m_signers;
+    Botan::PK_Signer *m_signer;
 
     virtual void prepare(Session &session, Object &obj, std::optional<size_t> threadindex) override;
+    virtual void rebind(Session &session, Object &obj) override;
     virtual void crashtestdummy(Session &session) override;
     virtual P11RSASigBenchmark *clone() const override;
 
+    // signer(): retrieve the signer bound to a session, create it if needed
+    Botan::PK_Signer *signer(Session &session, ObjectHandle handle);
+
 public:
 
     P11RSASigBenchmark(const std::string &name);
@@ -0,0 +1,249 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// processgroup.cpp: a group of forked worker processes, synchronized on a shared-memory barrier
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "processgroup.hpp"
+
+namespace {
+    [[noreturn]] void throw_errno(const char *what)
+    {
+	throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void write_all(int fd, const void *buf, std::size_t len)
+    {
+	auto p = static_cast<const char *>(buf);
+	std::size_t done = 0;
+	while(done < len) {
+	    auto rc = ::write(fd, p + done, len - done);
+	    if(rc < 0) {
+		if(errno == EINTR) continue;
+		throw_errno("write to parent process");
+	    }
+	    done += rc;
+	}
+    }
+}
+
+
+ProcessGroup::ProcessGroup(std::size_t numprocesses) : m_numprocesses(numprocesses)
+{
+    // the barrier lives in an anonymous shared mapping, inherited by all workers
+    void *shm = ::mmap(nullptr, sizeof(pthread_barrier_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(shm == MAP_FAILED) {
+	throw_errno("mmap");
+    }
+    m_barrier = static_cast<pthread_barrier_t *>(shm);
+
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    int rc = pthread_barrier_init(m_barrier, &attr, static_cast<unsigned>(numprocesses));
+    pthread_barrierattr_destroy(&attr);
+    if(rc != 0) {
+	throw std::system_error(rc, std::generic_category(), "pthread_barrier_init");
+    }
+
+    // pending output would otherwise be written by every process
+    std::fflush(nullptr);
+
+    for(std::size_t i=0; i<numprocesses; i++) {
+	int fds[2];
+	if(::pipe(fds) < 0) {
+	    abort();
+	    throw_errno("pipe");
+	}
+
+	pid_t pid = ::fork();
+	if(pid < 0) {
+	    abort();
+	    throw_errno("fork");
+	}
+
+	if(pid == 0) {
+	    // worker: keep only the write end of our own pipe
+	    ::close(fds[0]);
+	    for(auto fd: m_fds) {
+		::close(fd);
+	    }
+	    m_fds.assign(1, fds[1]);
+	    m_pids.clear();
+	    m_index = static_cast<int>(i);
+	    return;
+	}
+
+	::close(fds[1]);
+	m_fds.push_back(fds[0]);
+	m_pids.push_back(pid);
+    }
+}
+
+ProcessGroup::~ProcessGroup()
+{
+    for(auto fd: m_fds) {
+	::close(fd);
+    }
+    ::munmap(m_barrier, sizeof(pthread_barrier_t));
+}
+
+void ProcessGroup::arrive_and_wait()
+{
+    int rc = pthread_barrier_wait(m_barrier);
+    if(rc != 0 && rc != PTHREAD_BARRIER_SERIAL_THREAD) {
+	throw std::system_error(rc, std::generic_category(), "pthread_barrier_wait");
+    }
+}
+
+void ProcessGroup::send(const std::string &record)
+{
+    // records are length-prefixed
+    std::uint64_t len = record.size();
+    write_all(m_fds[0], &len, sizeof len);
+    write_all(m_fds[0], record.data(), record.size());
+}
+
+bool ProcessGroup::receive(std::vector<std::string> &records)
+{
+    // records are read as they come, from all workers at once: a worker may be blocked
+    // on the barrier, waiting for another one that is gone, and would never send its record.
+    struct Pending {
+	std::uint64_t len { 0 };
+	std::size_t got { 0 };	// bytes received so far, including the length prefix
+	bool done { false };
+	bool ended { false };
+    };
+    std::vector<Pending> pending(m_fds.size());
+    records.assign(m_fds.size(), std::string());
+
+    std::size_t remaining = m_fds.size(), ended = 0;
+    int timeout = -1;
+
+    while(remaining > 0) {
+	std::vector<pollfd> pfds;
+	std::vector<std::size_t> which;
+	for(std::size_t i=0; i<m_fds.size(); i++) {
+	    if(!pending[i].done) {
+		pfds.push_back( { m_fds[i], POLLIN, 0 } );
+		which.push_back(i);
+	    }
+	}
+
+	int rc = ::poll(pfds.data(), pfds.size(), timeout);
+	if(rc < 0) {
+	    if(errno == EINTR) continue;
+	    throw_errno("poll");
+	}
+	if(rc == 0) {
+	    throw std::runtime_error("worker processes are out of step");
+	}
+
+	for(std::size_t k=0; k<pfds.size(); k++) {
+	    if(pfds[k].revents == 0) continue;
+	    auto i = which[k];
+	    auto &p = pending[i];
+	    char buf[65536];
+	    std::size_t want = p.got < sizeof p.len ? sizeof p.len - p.got : std::min<std::uint64_t>(sizeof buf, p.len + sizeof p.len - p.got);
+	    auto n = ::read(m_fds[i], buf, want);
+	    if(n < 0) {
+		if(errno == EINTR) continue;
+		throw_errno("read from worker process");
+	    }
+
+	    if(n == 0) {
+		if(p.got > 0) {
+		    throw std::runtime_error("truncated record from worker process");
+		}
+		p.done = p.ended = true;
+		remaining--;
+		ended++;
+		// a worker that has no more records must have completed successfully,
+		// and the others are expected to follow shortly
+		int status = 0;
+		pid_t rc;
+		do { rc = ::waitpid(m_pids[i], &status, 0); } while(rc < 0 && errno == EINTR);
+		m_pids[i] = 0;
+		if(rc < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		    throw std::runtime_error("worker process #" + std::to_string(i) + " failed");
+		}
+		timeout = 60000;
+		continue;
+	    }
+
+	    // reads never go across the length prefix and the payload, see 'want' above
+	    if(p.got < sizeof p.len) {
+		std::copy(buf, buf + n, reinterpret_cast<char *>(&p.len) + p.got);
+		if(p.got + n == sizeof p.len) {
+		    records[i].reserve(p.len);
+		}
+	    } else {
+		records[i].append(buf, n);
+	    }
+	    p.got += n;
+
+	    if(p.got >= sizeof p.len && records[i].size() == p.len) {
+		p.done = true;
+		remaining--;
+	    }
+	}
+    }
+
+    if(ended > 0 && ended < m_fds.size()) {
+	throw std::runtime_error("worker processes are out of step");
+    }
+    return ended == 0;
+}
+
+void ProcessGroup::abort()
+{
+    // workers may be blocked on the barrier, waiting for a worker that is gone
+    for(auto pid: m_pids) {
+	if(pid != 0) {
+	    ::kill(pid, SIGTERM);
+	}
+    }
+}
+
+bool ProcessGroup::wait()
+{
+    bool success = true;
+    for(auto pid: m_pids) {
+	if(pid == 0) {
+	    continue;		// already reaped
+	}
+	int status = 0;
+	pid_t rc;
+	do { rc = ::waitpid(pid, &status, 0); } while(rc < 0 && errno == EINTR);
+	if(rc < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+	    success = false;
+	}
+    }
+    m_pids.clear();
+    return success;
+}
@@ -0,0 +1,71 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// processgroup.hpp: a group of forked worker processes, synchronized on a shared-memory barrier
+//
+// The parent process forks the workers, then acts as a coordinator: it receives the records sent
+// by the workers through pipes, one per worker and per step, until all workers are done.
+// Workers must be forked before the PKCS#11 library is loaded, so each of them initializes its own instance.
+
+#if !defined(PROCESSGROUP_H)
+#define PROCESSGROUP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <sys/types.h>
+
+class ProcessGroup
+{
+public:
+    // constructor: fork numprocesses workers. Throws std::system_error on failure.
+    explicit ProcessGroup(std::size_t numprocesses);
+    ~ProcessGroup();
+
+    ProcessGroup( const ProcessGroup &) = delete;
+    ProcessGroup& operator=( const ProcessGroup &) = delete;
+
+    inline bool is_parent() const { return m_index < 0; }
+    inline std::size_t index() const { return static_cast<std::size_t>(m_index); }
+    inline std::size_t size() const { return m_numprocesses; }
+
+    // worker side
+    // arrive_and_wait(): block until all workers have arrived
+    void arrive_and_wait();
+    // send(): send a record to the parent
+    void send(const std::string &record);
+
+    // parent side
+    // receive(): receive one record from each worker.
+    // returns false when all workers are done; throws std::runtime_error if only some of them are.
+    bool receive(std::vector<std::string> &records);
+    // abort(): terminate all workers
+    void abort();
+    // wait(): wait for all workers to exit. returns true if all of them succeeded.
+    bool wait();
+
+private:
+    std::size_t m_numprocesses;
+    int m_index { -1 };				// index of the worker, -1 in parent
+    pthread_barrier_t *m_barrier { nullptr };	// in shared memory
+    std::vector<pid_t> m_pids;			// parent only
+    std::vector<int> m_fds;			// read ends of pipes in parent, write end at m_fds[0] in worker
+};
+
+#endif // PROCESSGROUP_H
@@ -0,0 +1,105 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// recordbuffer.hpp: a growable buffer to store measures, made of fixed-size chunks
+//
+// Unlike std::vector, growing the buffer never moves already recorded items,
+// so the cost of recording a measure remains constant, whatever the length of the run.
+
+#if !defined(RECORDBUFFER_H)
+#define RECORDBUFFER_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+template<typename T, std::size_t ChunkSize = 8192>
+class RecordBuffer
+{
+    std::vector<std::unique_ptr<T[]> > m_chunks;
+    std::size_t m_size {0};
+
+public:
+    class const_iterator
+    {
+	const RecordBuffer *m_buffer;
+	std::size_t m_index;
+
+    public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T*;
+	using reference = const T&;
+
+	const_iterator(const RecordBuffer *buffer, std::size_t index) : m_buffer(buffer), m_index(index) { }
+
+	inline reference operator*() const { return (*m_buffer)[m_index]; }
+	inline pointer operator->() const { return &(*m_buffer)[m_index]; }
+	inline const_iterator& operator++() { ++m_index; return *this; }
+	inline const_iterator operator++(int) { auto rv = *this; ++m_index; return rv; }
+	inline bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+	inline bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+    };
+
+    RecordBuffer() = default;
+    RecordBuffer(RecordBuffer &&) = default;
+    RecordBuffer& operator=(RecordBuffer &&) = default;
+
+    RecordBuffer(const RecordBuffer &other) { *this = other; }
+    RecordBuffer& operator=(const RecordBuffer &other) {
+	if(this != &other) {
+	    clear();
+	    for(auto &item: other) {
+		push_back(item);
+	    }
+	}
+	return *this;
+    }
+
+    // push_back(): append an item, allocating a new chunk when the last one is full
+    inline void push_back(const T &item) {
+	if(m_size == m_chunks.size() * ChunkSize) {
+	    m_chunks.emplace_back(new T[ChunkSize]);
+	}
+	m_chunks.back()[m_size % ChunkSize] = item;
+	++m_size;
+    }
+
+    // reserve(): allocate chunks in advance, so that at least count items can be recorded without allocating.
+    // Chunks are written to, so their pages are first touched by the calling thread (i.e. on its local NUMA node).
+    void reserve(std::size_t count) {
+	while(m_chunks.size() * ChunkSize < count) {
+	    m_chunks.emplace_back(new T[ChunkSize]());
+	}
+    }
+
+    inline T& operator[](std::size_t index) { return m_chunks[index / ChunkSize][index % ChunkSize]; }
+    inline const T& operator[](std::size_t index) const { return m_chunks[index / ChunkSize][index % ChunkSize]; }
+
+    inline std::size_t size() const noexcept { return m_size; }
+    inline bool empty() const noexcept { return m_size == 0; }
+    inline void clear() noexcept { m_chunks.clear(); m_size = 0; }
+
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    inline const_iterator end() const noexcept { return const_iterator(this, m_size); }
+};
+
+
+#endif // RECORDBUFFER_H
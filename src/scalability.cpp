@@ -0,0 +1,170 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// scalability.cpp: throughput scalability models, fitted over several concurrency levels
+
+#include <cmath>
+#include <limits>
+#include "scalability.hpp"
+
+namespace {
+
+    using points_t = std::vector<std::pair<double,double> >;
+
+    inline double shape(double n, double sigma, double kappa)
+    {
+	return n / (1.0 + sigma * (n - 1.0) + kappa * n * (n - 1.0));
+    }
+
+    // for given sigma and kappa, the model is linear in lambda,
+    // so the best lambda has a closed form: sum(X.f)/sum(f^2)
+    ScalabilityModel evaluate(const points_t &points, double sigma, double kappa, double &sse)
+    {
+	double sxf = 0.0, sff = 0.0;
+	for(auto &[n, x]: points) {
+	    auto f = shape(n, sigma, kappa);
+	    sxf += x * f;
+	    sff += f * f;
+	}
+
+	ScalabilityModel model;
+	model.lambda = sff > 0 ? sxf / sff : 0.0;
+	model.sigma = sigma;
+	model.kappa = kappa;
+
+	sse = 0.0;
+	for(auto &[n, x]: points) {
+	    auto residual = x - model.lambda * shape(n, sigma, kappa);
+	    sse += residual * residual;
+	}
+	return model;
+    }
+
+    // golden section search of the minimum of f over [lo, hi]
+    // the bounds are checked too, as the minimum often lies there (e.g. no contention)
+    template<typename F>
+    double golden_section(F f, double lo, double hi, int iterations = 60)
+    {
+	const double lower = lo, upper = hi;
+	const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+	double a = hi - ratio * (hi - lo), b = lo + ratio * (hi - lo);
+	double fa = f(a), fb = f(b);
+
+	for(int i=0; i<iterations; i++) {
+	    if(fa < fb) {
+		hi = b; b = a; fb = fa;
+		a = hi - ratio * (hi - lo); fa = f(a);
+	    } else {
+		lo = a; a = b; fa = fb;
+		b = lo + ratio * (hi - lo); fb = f(b);
+	    }
+	}
+	double x = (lo + hi) / 2.0, fx = f(x);
+	if(f(lower) <= fx) {
+	    x = lower; fx = f(lower);
+	}
+	if(f(upper) < fx) {
+	    x = upper;
+	}
+	return x;
+    }
+
+    void compute_r2(const points_t &points, ScalabilityModel &model)
+    {
+	double mean = 0.0;
+	for(auto &p: points) mean += p.second;
+	mean /= points.size();
+
+	double sst = 0.0, sse = 0.0;
+	for(auto &[n, x]: points) {
+	    sst += (x - mean) * (x - mean);
+	    sse += (x - model.throughput(n)) * (x - model.throughput(n));
+	}
+	model.r2 = sst > 0 ? 1.0 - sse / sst : 1.0;
+    }
+}
+
+double ScalabilityModel::throughput(double n) const
+{
+    return lambda * shape(n, sigma, kappa);
+}
+
+std::optional<double> ScalabilityModel::peak_concurrency() const
+{
+    if(kappa <= 0 || sigma >= 1) {
+	return std::nullopt;
+    }
+    return std::sqrt((1.0 - sigma) / kappa);
+}
+
+ScalabilityModel fit_amdahl(const points_t &points)
+{
+    double sse;
+    auto sigma = golden_section([&](double s) { evaluate(points, s, 0.0, sse); return sse; }, 0.0, 1.0);
+    auto model = evaluate(points, sigma, 0.0, sse);
+    compute_r2(points, model);
+    return model;
+}
+
+ScalabilityModel fit_usl(const points_t &points)
+{
+    // the error surface is not guaranteed to be convex, so we start with a coarse grid search,
+    // sigma on a linear scale and kappa on a logarithmic scale, then refine around the best point.
+    double best_sse = std::numeric_limits<double>::max(), best_sigma = 0.0, best_kappa = 0.0;
+    int best_k = -1;
+    const int kgrid = 36;	// kappa from 1e-8 to 1, four steps per decade
+    auto kappa_at = [](int k) { return k < 0 ? 0.0 : std::pow(10.0, -8.0 + k * 0.25); };
+
+    for(int k=-1; k<kgrid; k++) {
+	for(int s=0; s<=100; s++) {
+	    double sse;
+	    evaluate(points, s / 100.0, kappa_at(k), sse);
+	    if(sse < best_sse) {
+		best_sse = sse;
+		best_sigma = s / 100.0;
+		best_kappa = kappa_at(k);
+		best_k = k;
+	    }
+	}
+    }
+
+    // refine: nested golden section searches within the neighbouring grid cells
+    double klo = best_k < 0 ? 0.0 : kappa_at(best_k - 1);
+    double khi = kappa_at(best_k + 1);
+    double slo = std::max(0.0, best_sigma - 0.01), shi = std::min(1.0, best_sigma + 0.01);
+
+    auto best_sigma_for = [&](double kappa) {
+	double sse;
+	return golden_section([&](double s) { evaluate(points, s, kappa, sse); return sse; }, slo, shi, 40);
+    };
+
+    auto kappa = golden_section([&](double k) {
+	double sse;
+	evaluate(points, best_sigma_for(k), k, sse);
+	return sse;
+    }, klo, khi, 40);
+    auto sigma = best_sigma_for(kappa);
+
+    double sse;
+    auto model = evaluate(points, sigma, kappa, sse);
+    if(sse > best_sse) {	// refinement did not help, stick to the grid point
+	model = evaluate(points, best_sigma, best_kappa, sse);
+    }
+    compute_r2(points, model);
+    return model;
+}
@@ -0,0 +1,59 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// scalability.hpp: throughput scalability models, fitted over several concurrency levels
+//
+// Universal Scalability Law (N. Gunther):
+//
+//                       lambda . N
+//   X(N) = ---------------------------------------
+//           1 + sigma . (N - 1) + kappa . N . (N - 1)
+//
+// where lambda is the throughput of a single thread, sigma the contention coefficient
+// (serialized portion of the work) and kappa the coherency coefficient (crosstalk between threads).
+// Amdahl's law is the special case where kappa = 0.
+
+#if !defined(SCALABILITY_H)
+#define SCALABILITY_H
+
+#include <vector>
+#include <utility>
+#include <optional>
+
+struct ScalabilityModel
+{
+    double lambda {0};		// throughput of a single thread
+    double sigma {0};		// contention coefficient
+    double kappa {0};		// coherency coefficient
+    double r2 {0};		// coefficient of determination of the fit
+
+    // throughput(): throughput predicted by the model, for n threads
+    double throughput(double n) const;
+
+    // peak_concurrency(): number of threads for which throughput is maximal.
+    // There is none when kappa is zero, as throughput then grows asymptotically towards lambda/sigma
+    std::optional<double> peak_concurrency() const;
+};
+
+// fit_amdahl(), fit_usl(): least-squares fits of the models, over (number of threads, throughput) points.
+// Amdahl's law needs at least two points, USL at least three.
+ScalabilityModel fit_amdahl(const std::vector<std::pair<double,double> > &points);
+ScalabilityModel fit_usl(const std::vector<std::pair<double,double> > &points);
+
+
+#endif // SCALABILITY_H
@@ -0,0 +1,54 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// sessionpool.cpp: a pool of PKCS#11 sessions, shared among benchmark threads
+
+#include <thread>
+#include <stdexcept>
+#include "sessionpool.hpp"
+
+thread_local std::size_t SessionPool::t_last = 0;
+
+SessionPool::SessionPool(std::vector<std::unique_ptr<Session> > sessions)
+    : m_entries(new Entry[sessions.size()]), m_size(sessions.size())
+{
+    if(m_size==0) {
+	throw std::invalid_argument("a session pool needs at least one session");
+    }
+
+    for(std::size_t i=0; i<m_size; i++) {
+	m_entries[i].session = std::move(sessions[i]);
+    }
+}
+
+std::size_t SessionPool::checkout()
+{
+    for(;;) {
+	for(std::size_t i=0; i<m_size; i++) {
+	    auto index = (t_last + i) % m_size;
+	    auto &busy = m_entries[index].busy;
+	    // read first, to avoid bouncing the cache line of a busy entry
+	    if(!busy.load(std::memory_order_relaxed) && !busy.exchange(true, std::memory_order_acquire)) {
+		t_last = index;
+		return index;
+	    }
+	}
+	std::this_thread::yield();
+    }
+}
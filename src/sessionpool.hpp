@@ -0,0 +1,84 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+// sessionpool.hpp: a pool of PKCS#11 sessions, shared among benchmark threads
+//
+// Threads check out a session before each operation, and return it right after.
+// Checkout is lock-free: each session has its own busy flag, claimed with an atomic exchange.
+// The scan starts at the session last used by the calling thread, so that each thread keeps
+// its own session when there are as many sessions as threads.
+
+#if !defined(SESSIONPOOL_H)
+#define SESSIONPOOL_H
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <botan/p11_types.h>
+
+using namespace Botan::PKCS11;
+
+class SessionPool
+{
+    // each entry sits on its own cache line, so that threads claiming different sessions do not contend
+    struct alignas(64) Entry {
+	std::unique_ptr<Session> session;
+	std::atomic<bool> busy {false};
+    };
+
+    std::unique_ptr<Entry[]> m_entries;
+    std::size_t m_size;
+
+    static thread_local std::size_t t_last; // index of the session last checked out by the thread
+
+public:
+    explicit SessionPool(std::vector<std::unique_ptr<Session> > sessions);
+
+    SessionPool( const SessionPool &) = delete;
+    SessionPool& operator=( const SessionPool &) = delete;
+
+    // checkout(): claim a free session, and return its index.
+    // When all sessions are busy, the calling thread yields, and scans again.
+    std::size_t checkout();
+
+    // checkin(): return a session claimed with checkout()
+    inline void checkin(std::size_t index) { m_entries[index].busy.store(false, std::memory_order_release); }
+
+    inline Session &session(std::size_t index) { return *m_entries[index].session; }
+    inline std::size_t size() const { return m_size; }
+
+    // Lease: a session checked out for the lifetime of the object
+    class Lease
+    {
+	SessionPool &m_pool;
+	std::size_t m_index;
+
+    public:
+	explicit Lease(SessionPool &pool) : m_pool(pool), m_index(pool.checkout()) { }
+	~Lease() { m_pool.checkin(m_index); }
+
+	Lease( const Lease &) = delete;
+	Lease& operator=( const Lease &) = delete;
+
+	inline Session &session() { return m_pool.session(m_index); }
+    };
+};
+
+#endif // SESSIONPOOL_H
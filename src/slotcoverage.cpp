@@ -0,0 +1,88 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// slotcoverage.cpp: a class to handle the list of slots to spread threads on, with optional weights
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/tokenizer.hpp>
+#include "slotcoverage.hpp"
+
+SlotCoverage::SlotCoverage(std::string tocover)
+{
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > toparse(tocover, sep);
+
+    for(auto token : toparse) {
+	char *next = nullptr;
+	long index = std::strtol(token.c_str(), &next, 10);
+	long weight = 1;
+
+	if(next != token.c_str() && *next == ':') {
+	    weight = std::strtol(next+1, &next, 10);
+	}
+
+	if(next == token.c_str() || *next != '\0' || index < 0 || weight < 1) {
+	    std::cerr << "Invalid slot: " << token << ", skipping." << std::endl;
+	    continue;
+	}
+
+	auto found = std::find_if(m_slots.begin(), m_slots.end(), [&](auto &slot) { return slot.first == index; });
+	if(found != m_slots.end()) {
+	    std::cerr << "Slot " << index << " specified more than once, skipping." << std::endl;
+	    continue;
+	}
+
+	m_slots.emplace_back(static_cast<int>(index), static_cast<unsigned>(weight));
+    }
+}
+
+std::vector<int> SlotCoverage::indices() const
+{
+    std::vector<int> rv;
+    for(auto &slot: m_slots) {
+	rv.push_back(slot.first);
+    }
+    return rv;
+}
+
+std::vector<int> SlotCoverage::assign(std::size_t numthreads) const
+{
+    // smooth weighted round-robin: at each step, every slot earns its weight,
+    // and the richest slot gets the thread, paying the total of weights.
+    std::vector<long> credit(m_slots.size(), 0);
+    long total = 0;
+    for(auto &slot: m_slots) {
+	total += slot.second;
+    }
+
+    std::vector<int> rv;
+    for(std::size_t th=0; th<numthreads && !m_slots.empty(); th++) {
+	std::size_t richest = 0;
+	for(std::size_t i=0; i<m_slots.size(); i++) {
+	    credit[i] += m_slots[i].second;
+	    if(credit[i] > credit[richest]) {
+		richest = i;
+	    }
+	}
+	credit[richest] -= total;
+	rv.push_back(m_slots[richest].first);
+    }
+    return rv;
+}
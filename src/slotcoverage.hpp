@@ -0,0 +1,51 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// slotcoverage.hpp: a class to handle the list of slots to spread threads on, with optional weights
+//
+// The list is made of comma-separated slot indices, each optionally followed by a weight, e.g. "0,1" or "0:3,1:1".
+// Threads are assigned to slots using a smooth weighted round-robin: any number of first threads
+// is spread as evenly as possible, according to the weights.
+
+#if !defined(SLOTCOVERAGE_H)
+#define SLOTCOVERAGE_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+class SlotCoverage
+{
+public:
+    SlotCoverage(std::string tocover);
+
+    inline bool empty() const noexcept { return m_slots.empty(); }
+    inline std::size_t size() const noexcept { return m_slots.size(); }
+
+    // indices(): slot indices, in the order given
+    std::vector<int> indices() const;
+
+    // assign(): slot index for each of the numthreads threads
+    std::vector<int> assign(std::size_t numthreads) const;
+
+private:
+    std::vector<std::pair<int, unsigned> > m_slots; // slot index, weight
+};
+
+
+#endif // SLOTCOVERAGE_H
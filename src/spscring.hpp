@@ -0,0 +1,79 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// spscring.hpp: a bounded, lock-free queue between a single producer and a single consumer
+//
+// Items are pushed and popped without locks nor system calls: the producer never waits,
+// and try_push() fails when the ring is full. Head and tail are kept on distinct cache lines.
+
+#if !defined(SPSCRING_H)
+#define SPSCRING_H
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+template<typename T>
+class SpscRing
+{
+    std::unique_ptr<T[]> m_items;
+    std::size_t m_mask;
+    alignas(64) std::atomic<std::size_t> m_head {0}; // next item to pop, written by the consumer
+    alignas(64) std::atomic<std::size_t> m_tail {0}; // next item to push, written by the producer
+
+public:
+    // the capacity is rounded up to a power of two
+    explicit SpscRing(std::size_t capacity) {
+	std::size_t size = 1;
+	while(size < capacity) {
+	    size <<= 1;
+	}
+	m_items.reset(new T[size]());
+	m_mask = size - 1;
+    }
+
+    SpscRing( const SpscRing &) = delete;
+    SpscRing& operator=( const SpscRing &) = delete;
+
+    // try_push(): from the producer, append an item, unless the ring is full
+    inline bool try_push(const T &item) {
+	auto tail = m_tail.load(std::memory_order_relaxed);
+	if(tail - m_head.load(std::memory_order_acquire) > m_mask) {
+	    return false;
+	}
+	m_items[tail & m_mask] = item;
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+    }
+
+    // try_pop(): from the consumer, take the oldest item, unless the ring is empty
+    inline bool try_pop(T &item) {
+	auto head = m_head.load(std::memory_order_relaxed);
+	if(head == m_tail.load(std::memory_order_acquire)) {
+	    return false;
+	}
+	item = m_items[head & m_mask];
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+    }
+
+    inline std::size_t capacity() const noexcept { return m_mask + 1; }
+};
+
+
+#endif // SPSCRING_H
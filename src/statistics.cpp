@@ -0,0 +1,162 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// statistics.cpp: statistics over a sample of latencies, kept in a contiguous buffer
+
+#include <cmath>
+#include <algorithm>
+#include <thread>
+#include "statistics.hpp"
+
+namespace {
+    // below that size, sorting in a single thread is faster than spawning threads
+    constexpr std::size_t parallel_threshold = 1 << 16;
+
+    // sum(): sum of values, over 4 independent lanes
+    double sum(const std::vector<double> &values)
+    {
+	double lanes[4] = { 0, 0, 0, 0 };
+	const std::size_t n = values.size(), whole = n - n % 4;
+	const double *data = values.data();
+	for(std::size_t i=0; i<whole; i+=4) {
+	    lanes[0] += data[i];
+	    lanes[1] += data[i+1];
+	    lanes[2] += data[i+2];
+	    lanes[3] += data[i+3];
+	}
+	for(std::size_t i=whole; i<n; i++) {
+	    lanes[0] += data[i];
+	}
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // squares(): sum of squared deviations from the mean, over 4 independent lanes
+    double squares(const std::vector<double> &values, double mean)
+    {
+	double lanes[4] = { 0, 0, 0, 0 };
+	const std::size_t n = values.size(), whole = n - n % 4;
+	const double *data = values.data();
+	for(std::size_t i=0; i<whole; i+=4) {
+	    double d0 = data[i] - mean, d1 = data[i+1] - mean, d2 = data[i+2] - mean, d3 = data[i+3] - mean;
+	    lanes[0] += d0 * d0;
+	    lanes[1] += d1 * d1;
+	    lanes[2] += d2 * d2;
+	    lanes[3] += d3 * d3;
+	}
+	for(std::size_t i=whole; i<n; i++) {
+	    double d = data[i] - mean;
+	    lanes[0] += d * d;
+	}
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // ks(): Kolmogorov-Smirnov statistic of a sorted sample, against a normal distribution
+    // D = max|F(x) - F_n(x)|, where F_n is the empirical CDF, checked on both sides of each step
+    double ks(const std::vector<double> &sorted, double mean, double svar)
+    {
+	const std::size_t n = sorted.size();
+	if(n < 2) {
+	    return 0.0;
+	}
+	const double scale = std::sqrt(svar) * std::sqrt(2.0);
+	double D = 0.0;
+	for(std::size_t i=0; i<n; i++) {
+	    double F = 0.5 * (1.0 + std::erf((sorted[i] - mean) / scale));
+	    D = std::max({ D, std::abs(F - static_cast<double>(i) / n), std::abs(F - static_cast<double>(i + 1) / n) });
+	}
+	return D;
+    }
+}
+
+void parallel_sort(std::vector<double> &values)
+{
+    const std::size_t workers = std::min<std::size_t>(std::thread::hardware_concurrency(), values.size() / parallel_threshold);
+    if(workers < 2) {
+	std::sort(values.begin(), values.end());
+	return;
+    }
+
+    // a power of two of chunks, so they can be merged pairwise
+    std::size_t chunks = 1;
+    while(chunks * 2 <= workers) {
+	chunks *= 2;
+    }
+    std::vector<std::vector<double>::iterator> bounds;
+    for(std::size_t i=0; i<=chunks; i++) {
+	bounds.push_back(values.begin() + values.size() * i / chunks);
+    }
+
+    std::vector<std::thread> threads;
+    for(std::size_t i=0; i<chunks; i++) {
+	threads.emplace_back( [&bounds, i] { std::sort(bounds[i], bounds[i+1]); } );
+    }
+    for(auto &thread: threads) {
+	thread.join();
+    }
+
+    for(std::size_t width=1; width<chunks; width*=2) {
+	threads.clear();
+	for(std::size_t i=0; i<chunks; i+=2*width) {
+	    threads.emplace_back( [&bounds, i, width] { std::inplace_merge(bounds[i], bounds[i+width], bounds[i+2*width]); } );
+	}
+	for(auto &thread: threads) {
+	    thread.join();
+	}
+    }
+}
+
+SampleStatistics::SampleStatistics(std::vector<double> &&sample) : m_sorted(std::move(sample))
+{
+    const std::size_t n = m_sorted.size();
+    if(n == 0) {
+	return;
+    }
+
+    parallel_sort(m_sorted);
+
+    m_mean = sum(m_sorted) / n;
+    m_svar = n > 1 ? squares(m_sorted, m_mean) / (n - 1) : 0.0;
+
+    // for small values, log1p() is numerically more stable
+    m_log1p = m_mean < 1.0;
+    m_logs.resize(n);
+    for(std::size_t i=0; i<n; i++) {
+	m_logs[i] = m_log1p ? std::log1p(m_sorted[i]) : std::log(m_sorted[i]);
+    }
+    m_logmean = sum(m_logs) / n;
+    m_logsvar = n > 1 ? squares(m_logs, m_logmean) / (n - 1) : 0.0;
+}
+
+double SampleStatistics::percentile(double p) const
+{
+    if(empty()) {
+	return 0.0;
+    }
+    auto rank = static_cast<std::size_t>(std::ceil(p * count()));
+    return at(std::clamp<std::size_t>(rank, 1, count()));
+}
+
+double SampleStatistics::ks_normal() const
+{
+    return ks(m_sorted, m_mean, m_svar);
+}
+
+double SampleStatistics::ks_lognormal() const
+{
+    return ks(m_logs, m_logmean, m_logsvar);
+}
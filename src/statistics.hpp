@@ -0,0 +1,76 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// statistics.hpp: statistics over a sample of latencies, kept in a contiguous buffer
+//
+// The sample is sorted once (in parallel, for large samples), and the sorted order serves
+// the minimum, maximum, order statistics and goodness-of-fit tests alike. The logarithm being monotonic,
+// the log-transformed sample is sorted as well. Sums are accumulated over independent lanes,
+// which compilers map onto SIMD registers.
+
+#if !defined(STATISTICS_H)
+#define STATISTICS_H
+
+#include <cstddef>
+#include <vector>
+
+class SampleStatistics
+{
+    std::vector<double> m_sorted;	// the sample, in increasing order
+    std::vector<double> m_logs;		// log (or log1p) of the sample, in increasing order as well
+    bool m_log1p {false};		// whether log1p() is used, for samples with an average below 1
+    double m_mean {0}, m_svar {0};
+    double m_logmean {0}, m_logsvar {0};
+
+public:
+    // the sample is taken over, in any order
+    explicit SampleStatistics(std::vector<double> &&sample);
+
+    inline std::size_t count() const { return m_sorted.size(); }
+    inline bool empty() const { return m_sorted.empty(); }
+
+    inline double min() const { return empty() ? 0.0 : m_sorted.front(); }
+    inline double max() const { return empty() ? 0.0 : m_sorted.back(); }
+    inline double mean() const { return m_mean; }
+    inline double variance() const { return m_svar; } // sample variance
+
+    // sorted(): the sample, in increasing order
+    inline const std::vector<double> &sorted() const { return m_sorted; }
+
+    // at(): value of a rank, from 1
+    inline double at(std::size_t rank) const { return m_sorted[rank - 1]; }
+
+    // percentile(): value of rank ceil(n.p)
+    double percentile(double p) const;
+
+    // statistics of the log-transformed sample (using log1p() when uses_log1p())
+    inline bool uses_log1p() const { return m_log1p; }
+    inline double logmean() const { return m_logmean; }
+    inline double logvariance() const { return m_logsvar; } // sample variance
+
+    // Kolmogorov-Smirnov statistic D, against a normal distribution of the same mean and variance,
+    // either of the sample or of the log-transformed sample
+    double ks_normal() const;
+    double ks_lognormal() const;
+};
+
+// parallel_sort(): sort a vector, in chunks sorted by as many threads as the hardware offers, then merged
+void parallel_sort(std::vector<double> &values);
+
+
+#endif // STATISTICS_H
@@ -90,6 +90,22 @@ TestCoverage::TestCoverage(std::string tocover)
 	    m_algo_coverage.insert(AlgoCoverage::find);
 	    break;
 
+	case "null"_hash:
+	    m_algo_coverage.insert(AlgoCoverage::null);
+	    break;
+
+	case "nullsessinfo"_hash:
+	    m_algo_coverage.insert(AlgoCoverage::nullsessinfo);
+	    break;
+
+	case "nullfnstatus"_hash:
+	    m_algo_coverage.insert(AlgoCoverage::nullfnstatus);
+	    break;
+
+	case "nullgetattr"_hash:
+	    m_algo_coverage.insert(AlgoCoverage::nullgetattr);
+	    break;
+
 	case "jwe"_hash:
 	    m_algo_coverage.insert(AlgoCoverage::jwe);
 	    break;
@@ -220,6 +236,22 @@ bool TestCoverage::contains(std::string algo)
 	return contains(AlgoCoverage::find);
 	break;
 
+    case "null"_hash:
+	return contains(AlgoCoverage::null);
+	break;
+
+    case "nullsessinfo"_hash:
+	return contains(AlgoCoverage::nullsessinfo);
+	break;
+
+    case "nullfnstatus"_hash:
+	return contains(AlgoCoverage::nullfnstatus);
+	break;
+
+    case "nullgetattr"_hash:
+	return contains(AlgoCoverage::nullgetattr);
+	break;
+
     case "jwe"_hash:
 	return contains(AlgoCoverage::jwe);
 	break;
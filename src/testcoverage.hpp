@@ -40,6 +40,10 @@ struct TestCoverage
 	xorder,			// XOR derivation
 	rand,			// Random number generation
 	find,			// Find objects
+	null,			// Null operations (all)
+	nullsessinfo,		// C_GetSessionInfo
+	nullfnstatus,		// C_GetFunctionStatus
+	nullgetattr,		// C_GetAttributeValue
 	jwe,			// JWE decryption (RFC7516)
 	jweoaepsha1,		// subset with OAEP(SHA1)
 	jweoaepsha256,		// subset with OAEP(SHA256)
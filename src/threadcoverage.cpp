@@ -0,0 +1,52 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <iostream>
+#include <cstdlib>
+#include <boost/tokenizer.hpp>
+#include "threadcoverage.hpp"
+
+ThreadCoverage::ThreadCoverage(std::string tocover)
+{
+    boost::char_separator<char> sep(",");
+    boost::tokenizer<boost::char_separator<char> > toparse(tocover, sep);
+
+    for(auto token : toparse) {
+	char *next = nullptr;
+	long first = std::strtol(token.c_str(), &next, 10);
+	long last = first, step = 1;
+	char stepkind = ':';
+
+	if(*next == '-') {
+	    last = std::strtol(next+1, &next, 10);
+	    if(*next == ':' || *next == '*') {
+		stepkind = *next;
+		step = std::strtol(next+1, &next, 10);
+	    }
+	}
+
+	if(*next != '\0' || first < 1 || last < first || step < 1 || (stepkind == '*' && step < 2)) {
+	    std::cerr << "Invalid number of threads: " << token << ", skipping." << std::endl;
+	    continue;
+	}
+
+	for(long n = first; n <= last; n = (stepkind == '*') ? n * step : n + step) {
+	    m_thread_coverage.insert(static_cast<int>(n));
+	}
+    }
+}
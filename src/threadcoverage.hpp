@@ -0,0 +1,53 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// threadcoverage.hpp: a class to select the numbers of threads to use during testing
+//
+// the specification is a comma-separated list, where each item is either:
+//  - a number of threads, e.g. 8
+//  - a range, e.g. 1-16 (all values from 1 to 16)
+//  - a range with an arithmetic step, e.g. 8-64:8 (8,16,24,...,64)
+//  - a range with a geometric factor, e.g. 1-64*2 (1,2,4,...,64)
+
+#if !defined(THREADCOVERAGE_H)
+#define THREADCOVERAGE_H
+
+#include <set>
+#include <string>
+
+class ThreadCoverage
+{
+public:
+    using set_type = std::set<int>;
+    using const_iterator = set_type::const_iterator;
+
+    ThreadCoverage(std::string tocover);
+
+    inline const_iterator begin() const noexcept { return m_thread_coverage.cbegin(); }
+    inline const_iterator end() const noexcept { return m_thread_coverage.cend(); }
+
+    inline bool empty() const noexcept { return m_thread_coverage.empty(); }
+    inline std::size_t size() const noexcept { return m_thread_coverage.size(); }
+    inline int max() const { return *m_thread_coverage.rbegin(); }
+
+private:
+    set_type m_thread_coverage;
+};
+
+
+#endif // THREADCOVERAGE_H
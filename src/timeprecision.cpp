@@ -17,6 +17,7 @@
 //
 
 #include "timeprecision.hpp"
+#include "timer.hpp"
 
 #include <chrono>
 #include <cmath>
@@ -33,11 +34,11 @@ using namespace boost::accumulators;
 
 
 // reference: https://www.statsdirect.com/help/basic_descriptive_statistics/standard_deviation.htm
-// returned time is in ns
+// returned time is in ns, for the timer source selected
 
 pair<nanoseconds_double_t, nanoseconds_double_t> measure_clock_precision(int iter)
 {
-    using clock = std::chrono::high_resolution_clock;
+    using clock = Timer;
     accumulator_set<double, stats<tag::mean, tag::variance, tag::count> > acc;
 
     for (int i = 0; i < iter; ++i) {
@@ -46,7 +47,7 @@ pair<nanoseconds_double_t, nanoseconds_double_t> measure_clock_precision(int ite
         while (current == start) {
             current = clock::now();
         }
-        const auto delta = std::chrono::duration_cast<nanoseconds_double_t>(current - start);
+        const auto delta = clock::duration(start, current);
         acc(delta.count());
     }
 
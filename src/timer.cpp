@@ -0,0 +1,123 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// timer.cpp: the clock used to time operations, with a selectable source
+
+#include <algorithm>
+#include <stdexcept>
+#include "timer.hpp"
+#if defined(TIMER_HAVE_TSC)
+#include <cpuid.h>
+#endif
+
+namespace {
+    // invariant_tsc(): whether the time-stamp counter runs at a constant rate, across all cores and power states
+    bool invariant_tsc()
+    {
+#if defined(TIMER_HAVE_TSC)
+	unsigned int eax, ebx, ecx, edx;
+	if(__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && eax >= 0x80000007
+	   && __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+	    return (edx & (1 << 8)) != 0;
+	}
+#endif
+	return false;
+    }
+}
+
+void Timer::select(Source source)
+{
+    using clock = std::chrono::steady_clock;
+
+    switch(source) {
+    case Source::tsc:
+	if(!invariant_tsc()) {
+	    throw std::invalid_argument("the tsc timer requires an invariant time-stamp counter, not available on this platform");
+	}
+	break;
+    case Source::monotonic_raw:
+#if !defined(CLOCK_MONOTONIC_RAW)
+	throw std::invalid_argument("the monotonic-raw timer is not available on this platform");
+#endif
+	break;
+    default:
+	break;
+    }
+
+    s_source = source;
+    s_period = 1.0;
+
+    // the period of the TSC is calibrated by timing a busy wait of 100ms with both clocks
+    if(source == Source::tsc) {
+	const auto from = clock::now();
+	const auto from_ticks = now();
+	auto to = from;
+	while(to - from < std::chrono::milliseconds(100)) {
+	    to = clock::now();
+	}
+	const auto to_ticks = now();
+	s_period = std::chrono::duration_cast<nanoseconds_double_t>(to - from).count() / (to_ticks - from_ticks);
+    }
+
+    // the cost of a read is the shortest average over batches of back-to-back reads, less likely to have been interrupted
+    constexpr int batches = 100;
+    constexpr int reads = 64;
+    s_overhead = nanoseconds_double_t::max();
+    for(int b = 0; b < batches; ++b) {
+	const auto first = now();
+	ticks_t last = first;
+	for(int r = 1; r < reads; ++r) {
+	    last = now();
+	}
+	s_overhead = std::min(s_overhead, duration(first, last) / (reads - 1));
+    }
+
+    s_origin = clock::now();
+    s_origin_ticks = now();
+}
+
+std::optional<Timer::Source> Timer::parse(const std::string &name)
+{
+    if(name == "steady") {
+	return Source::steady;
+    } else if(name == "monotonic-raw") {
+	return Source::monotonic_raw;
+    } else if(name == "tsc") {
+	return Source::tsc;
+    }
+    return std::nullopt;
+}
+
+std::string Timer::name()
+{
+    switch(s_source) {
+    case Source::monotonic_raw:
+	return "monotonic-raw";
+    case Source::tsc:
+	return "tsc";
+    default:
+	return "steady";
+    }
+}
+
+double Timer::drift()
+{
+    const auto ticks = now();
+    const auto reference = std::chrono::duration_cast<nanoseconds_double_t>(std::chrono::steady_clock::now() - s_origin);
+    return reference.count() > 0 ? (duration(s_origin_ticks, ticks) - reference) / reference * 1e6 : 0.0;
+}
@@ -0,0 +1,107 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// timer.hpp: the clock used to time operations, with a selectable source
+//
+// Reading the timer returns raw ticks, converted to nanoseconds only once an interval is taken,
+// so that a read costs as little as possible. Available sources are:
+//  - steady: std::chrono::steady_clock, the default;
+//  - monotonic-raw: CLOCK_MONOTONIC_RAW, which is not slewed by NTP (Linux only);
+//  - tsc: the invariant time-stamp counter, read with rdtscp, its period being calibrated against the steady clock (x86 only).
+// The source is process-wide, and must be selected before any worker thread (or process) is started.
+
+#if !defined(TIMER_H)
+#define TIMER_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIMER_HAVE_TSC
+#endif
+#include "units.hpp"
+
+class Timer
+{
+public:
+    enum class Source { steady, monotonic_raw, tsc };
+    using ticks_t = std::int64_t;
+
+private:
+    inline static Source s_source { Source::steady };
+    inline static double s_period { 1.0 }; // duration of a tick, in ns
+    inline static nanoseconds_double_t s_overhead { 0 }; // cost of a read, i.e. time added to each interval
+    inline static ticks_t s_origin_ticks { 0 }; // reference points taken at selection, to measure the drift
+    inline static std::chrono::steady_clock::time_point s_origin {};
+
+public:
+    // select(): choose the source, then calibrate it: period of ticks (tsc only), and cost of a read.
+    // throws std::invalid_argument if the source is not available on this platform.
+    static void select(Source source);
+
+    // parse(): retrieve a source from its name, steady, monotonic-raw or tsc
+    static std::optional<Source> parse(const std::string &name);
+
+    // source(): the selected source
+    static inline Source source() { return s_source; }
+
+    // name(): name of the selected source
+    static std::string name();
+
+    // now(): read the timer
+    static inline ticks_t now() {
+	switch(s_source) {
+#if defined(TIMER_HAVE_TSC)
+	case Source::tsc: {
+	    // rdtscp waits for the preceding instructions to complete; the fence keeps the following ones from starting early
+	    unsigned int aux;
+	    ticks_t ticks = __rdtscp(&aux);
+	    _mm_lfence();
+	    return ticks;
+	}
+#endif
+#if defined(CLOCK_MONOTONIC_RAW)
+	case Source::monotonic_raw: {
+	    struct timespec ts;
+	    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	    return static_cast<ticks_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+	}
+#endif
+	default:
+	    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+    }
+
+    // duration(): time elapsed between two reads
+    static inline nanoseconds_double_t duration(ticks_t from, ticks_t to) { return nanoseconds_double_t((to - from) * s_period); }
+
+    // overhead(): cost of a read, as measured at selection. An interval measured with two reads is inflated by about that much.
+    static inline nanoseconds_double_t overhead() { return s_overhead; }
+
+    // frequency(): number of ticks per second
+    static inline double frequency() { return 1e9 / s_period; }
+
+    // drift(): relative difference between the time elapsed since selection, as measured by the timer and by the steady clock, in ppm
+    static double drift();
+};
+
+
+#endif // TIMER_H
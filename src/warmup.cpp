@@ -0,0 +1,60 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// warmup.cpp: detection of the warm-up transient at the start of a series of measures
+
+#include <limits>
+#include "warmup.hpp"
+
+std::size_t mser5(const std::vector<double> &series)
+{
+    const std::size_t batchsize = 5;
+    const std::size_t n = series.size() / batchsize; // a last, incomplete batch is ignored
+
+    if(n < 2) {
+	return 0;
+    }
+
+    std::vector<double> z(n, 0.0);
+    for(std::size_t j=0; j<n; j++) {
+	for(std::size_t i=0; i<batchsize; i++) {
+	    z[j] += series[j*batchsize + i];
+	}
+	z[j] /= batchsize;
+    }
+
+    // suffix sums, so that every truncation point is evaluated in constant time
+    std::vector<double> sum(n+1, 0.0), sumsq(n+1, 0.0);
+    for(std::size_t j=n; j-- > 0; ) {
+	sum[j] = sum[j+1] + z[j];
+	sumsq[j] = sumsq[j+1] + z[j] * z[j];
+    }
+
+    std::size_t best = 0;
+    double lowest = std::numeric_limits<double>::max();
+    for(std::size_t d=0; d<=n/2; d++) {
+	const double remaining = n - d;
+	const double mser = (sumsq[d] - sum[d] * sum[d] / remaining) / (remaining * remaining);
+	if(mser < lowest) {
+	    lowest = mser;
+	    best = d;
+	}
+    }
+
+    return best * batchsize;
+}
@@ -0,0 +1,41 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// warmup.hpp: detection of the warm-up transient at the start of a series of measures
+//
+// MSER-5 (Marginal Standard Error Rule, K. P. White): the series is averaged over batches of 5 measures,
+// Z_1..Z_n, and the transient is made of the first d batches, where d minimizes
+//
+//                   1         n
+//   MSER(d) = ----------- .   Σ   (Z_j - mean(Z_d+1..Z_n))²
+//              (n - d)²     j=d+1
+//
+// i.e. the squared standard error of the mean of the remaining batches. Truncation points are only
+// searched in the first half of the series, as a series that does not settle would otherwise be cut short.
+
+#if !defined(WARMUP_H)
+#define WARMUP_H
+
+#include <cstddef>
+#include <vector>
+
+// mser5(): number of measures to trim at the start of the series (a multiple of 5)
+std::size_t mser5(const std::vector<double> &series);
+
+
+#endif // WARMUP_H
@@ -0,0 +1,99 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// workerpool.cpp: a pool of long-lived worker threads
+
+#include "workerpool.hpp"
+
+
+WorkerPool::WorkerPool(std::size_t numworkers)
+{
+    for(std::size_t i=0; i<numworkers; i++) {
+	m_threads.emplace_back(&WorkerPool::worker_loop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+	std::lock_guard<std::mutex> lck(m_mtx);
+	m_stop = true;
+    }
+    m_job_cond.notify_all();
+
+    for(auto &thread: m_threads) {
+	thread.join();
+    }
+}
+
+void WorkerPool::run(job_t job, std::size_t numworkers)
+{
+    std::unique_lock<std::mutex> lck(m_mtx);
+
+    m_job = std::move(job);
+    m_exception = nullptr;
+    m_active = (numworkers == 0 || numworkers > m_threads.size()) ? m_threads.size() : numworkers;
+    m_pending = m_active;
+    m_generation++;
+    m_job_cond.notify_all();
+
+    m_done_cond.wait(lck, [&] { return m_pending == 0; });
+    m_job = nullptr;
+
+    if(m_exception) {
+	std::rethrow_exception(m_exception);
+    }
+}
+
+void WorkerPool::worker_loop(std::size_t index)
+{
+    std::size_t generation = 0;
+
+    for(;;) {
+	job_t job;
+	{
+	    std::unique_lock<std::mutex> lck(m_mtx);
+	    m_job_cond.wait(lck, [&] { return m_stop || generation != m_generation; });
+	    if(m_stop) {
+		return;
+	    }
+	    generation = m_generation;
+	    if(index >= m_active) {
+		continue;	// not part of this job
+	    }
+	    job = m_job;
+	}
+
+	std::exception_ptr exception;
+	try {
+	    job(index);
+	} catch (...) {
+	    exception = std::current_exception();
+	}
+
+	{
+	    std::lock_guard<std::mutex> lck(m_mtx);
+	    if(exception && !m_exception) {
+		m_exception = exception;
+	    }
+	    if(--m_pending == 0) {
+		m_done_cond.notify_one();
+	    }
+	}
+    }
+}
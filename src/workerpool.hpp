@@ -0,0 +1,65 @@
+// -*- mode: c++; c-file-style:"stroustrup"; -*-
+
+//
+// Copyright (c) 2025 Mastercard
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// workerpool.hpp: a pool of long-lived worker threads
+
+#if !defined(WORKERPOOL_H)
+#define WORKERPOOL_H
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+class WorkerPool
+{
+public:
+    // a job receives the index of the worker executing it
+    using job_t = std::function<void(std::size_t)>;
+
+    explicit WorkerPool(std::size_t numworkers);
+    ~WorkerPool();
+
+    WorkerPool( const WorkerPool &) = delete;
+    WorkerPool& operator=( const WorkerPool &) = delete;
+
+    // run(): execute the job on the first numworkers workers (all of them by default),
+    // and wait until they are done. If a job throws, the first exception caught is rethrown to the caller.
+    void run(job_t job, std::size_t numworkers = 0);
+
+    inline std::size_t size() const { return m_threads.size(); }
+
+private:
+    void worker_loop(std::size_t index);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mtx;
+    std::condition_variable m_job_cond;	 // signals workers that a job is available
+    std::condition_variable m_done_cond; // signals the caller that all workers are done
+    job_t m_job;
+    std::size_t m_generation {0};	// incremented for each new job
+    std::size_t m_active {0};		// number of workers taking part in the current job
+    std::size_t m_pending {0};		// number of workers still busy with the current job
+    bool m_stop {false};
+    std::exception_ptr m_exception;
+};
+
+#endif // WORKERPOOL_H